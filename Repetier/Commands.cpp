@@ -25,6 +25,14 @@ int         Commands::lowestRAMValueSend = MAX_RAM;
 uint16_t    ExtruderTemp = 1;       // 0 = Extruder temperature is lower EXTRUDER_MIN_TEMP  1 = Extruder Temperature is higher EXTRUDER_MIN_TEMP
 uint16_t    BedTemp      = 1;       // 0 = Heatbed temperature is lower HEATED_BED_MIN_TEMP  1 = Heatbed Temperature is higher HEATED_BED_MIN_TEMP
 
+#if FEATURE_ASYNC_HEATUP
+uint8_t     Commands::pendingHeatUp = 0;
+#endif // FEATURE_ASYNC_HEATUP
+
+#if FEATURE_ADAPTIVE_TEMPERATURE_REPORT
+uint8_t     Commands::temperatureReportMode = TEMPERATURE_REPORT_MODE_DEFAULT;
+#endif // FEATURE_ADAPTIVE_TEMPERATURE_REPORT
+
 
 void Commands::commandLoop()
 {
@@ -92,7 +100,7 @@ void Commands::checkForPeriodicalActions()
       if(!buttonactive) UI_SLOW;
 
       Extruder::manageTemperatures();
-      Commands::printTemperatures(); //selfcontrolling timediff
+      Commands::reportTemperatures(); //selfcontrolling timediff
 
     }
 } // checkForPeriodicalActions
@@ -202,6 +210,154 @@ void Commands::waitUntilEndOfZOS()
 
 } // waitUntilEndOfZOS
 
+
+/** \brief Waits until the extruder has reached its target temperature and the temperature has stabilized. */
+void Commands::waitForExtruderTemperature(Extruder *actExtruder)
+{
+#if NUM_EXTRUDER>0
+    g_uStartOfIdle = 0;
+    UI_STATUS_UPD(UI_TEXT_HEATING_EXTRUDER);
+
+#if FEATURE_EXTENDED_BUTTONS || FEATURE_PAUSE_PRINTING
+    Printer::waitMove = 1;
+#endif // FEATURE_EXTENDED_BUTTONS || FEATURE_PAUSE_PRINTING
+
+    Commands::waitUntilEndOfAllMoves();
+
+    if(fabs(actExtruder->tempControl.targetTemperatureC - actExtruder->tempControl.currentTemperatureC) < TEMP_TOLERANCE)
+    {
+        // we are already in range
+
+#if FEATURE_EXTENDED_BUTTONS || FEATURE_PAUSE_PRINTING
+        Printer::waitMove = 0;
+#endif // FEATURE_EXTENDED_BUTTONS || FEATURE_PAUSE_PRINTING
+
+        return;
+    }
+
+    bool        dirRising   = actExtruder->tempControl.targetTemperature > actExtruder->tempControl.currentTemperature;
+    millis_t    waituntil   = 0;
+
+#if RETRACT_DURING_HEATUP
+    uint8_t     retracted = 0;
+#endif // RETRACT_DURING_HEATUP
+
+    millis_t currentTime;
+    do
+    {
+        currentTime = HAL::timeInMilliseconds();
+        Commands::printTemperatures();                       
+        Commands::checkForPeriodicalActions();
+        GCode::keepAlive( WaitHeater );
+#if RETRACT_DURING_HEATUP
+        if (actExtruder == Extruder::current && actExtruder->waitRetractUnits > 0 && !retracted && dirRising && actExtruder->tempControl.currentTemperatureC > actExtruder->waitRetractTemperature)
+        {
+            PrintLine::moveRelativeDistanceInSteps(0,0,0,-actExtruder->waitRetractUnits * Printer::axisStepsPerMM[E_AXIS],actExtruder->maxFeedrate,false,false);
+            retracted = 1;
+        }
+#endif // RETRACT_DURING_HEATUP
+
+        if((waituntil == 0 &&
+            (dirRising ? actExtruder->tempControl.currentTemperatureC >= actExtruder->tempControl.targetTemperatureC-TEMP_TOLERANCE : actExtruder->tempControl.currentTemperatureC <= actExtruder->tempControl.targetTemperatureC+TEMP_TOLERANCE))
+#if defined(TEMP_HYSTERESIS) && TEMP_HYSTERESIS>=1
+            || (waituntil!=0 && (abs(actExtruder->tempControl.currentTemperatureC - actExtruder->tempControl.targetTemperatureC))>TEMP_HYSTERESIS)
+#endif // #if defined(TEMP_HYSTERESIS) && TEMP_HYSTERESIS>=1
+          )
+        {
+            waituntil = currentTime+1000UL*(millis_t)actExtruder->watchPeriod; // now wait for temp. to stabalize
+        }
+    }
+    while(waituntil==0 || (waituntil!=0 && (millis_t)(waituntil-currentTime)<2000000000UL));
+
+#if RETRACT_DURING_HEATUP
+    if (retracted && actExtruder==Extruder::current)
+    {
+        PrintLine::moveRelativeDistanceInSteps(0,0,0,actExtruder->waitRetractUnits * Printer::axisStepsPerMM[E_AXIS],actExtruder->maxFeedrate,false,false);
+    }
+#endif // RETRACT_DURING_HEATUP
+
+#if FEATURE_EXTENDED_BUTTONS || FEATURE_PAUSE_PRINTING
+    Printer::waitMove = 0;
+#endif // FEATURE_EXTENDED_BUTTONS || FEATURE_PAUSE_PRINTING
+
+    g_uStartOfIdle    = HAL::timeInMilliseconds();
+    previousMillisCmd = HAL::timeInMilliseconds();
+#endif // NUM_EXTRUDER>0
+
+} // waitForExtruderTemperature
+
+
+/** \brief Waits until the heat bed has reached its target temperature. */
+void Commands::waitForHeatedBedTemperature()
+{
+#if HAVE_HEATED_BED
+    g_uStartOfIdle = 0;
+    UI_STATUS_UPD(UI_TEXT_HEATING_BED);
+
+#if FEATURE_EXTENDED_BUTTONS || FEATURE_PAUSE_PRINTING
+    Printer::waitMove = 1;
+#endif // FEATURE_EXTENDED_BUTTONS || FEATURE_PAUSE_PRINTING
+
+    Commands::waitUntilEndOfAllMoves();
+
+    if( fabs(heatedBedController.currentTemperatureC-heatedBedController.targetTemperatureC) < TEMP_TOLERANCE )
+    {
+        // we are already in range
+#if FEATURE_EXTENDED_BUTTONS || FEATURE_PAUSE_PRINTING
+        Printer::waitMove = 0;
+#endif // FEATURE_EXTENDED_BUTTONS || FEATURE_PAUSE_PRINTING
+        return;
+    }
+
+    while(heatedBedController.currentTemperatureC+TEMP_TOLERANCE < heatedBedController.targetTemperatureC)
+    {
+        Commands::printTemperatures();
+        Commands::checkForPeriodicalActions();
+        GCode::keepAlive( WaitHeater );
+    }
+
+#if FEATURE_EXTENDED_BUTTONS || FEATURE_PAUSE_PRINTING
+    Printer::waitMove = 0;
+#endif // FEATURE_EXTENDED_BUTTONS || FEATURE_PAUSE_PRINTING
+
+    g_uStartOfIdle    = HAL::timeInMilliseconds();
+    previousMillisCmd = HAL::timeInMilliseconds();
+#endif // HAVE_HEATED_BED
+
+} // waitForHeatedBedTemperature
+
+
+#if FEATURE_ASYNC_HEATUP
+/** \brief Waits for the heaters which have been started via M109/M190 in the background.
+    The heat bed is waited for first, because it is the slowest heater - the extruders continue to heat up meanwhile. */
+void Commands::waitForPendingHeatUp()
+{
+    uint8_t pending = pendingHeatUp;
+
+
+    // the pending heaters are kept, so that the next command which needs the temperature reports the error again
+    if(reportTempsensorError()) return;
+    pendingHeatUp = 0;
+
+#if HAVE_HEATED_BED
+    if((pending & (1 << NUM_EXTRUDER)) && heatedBedController.targetTemperatureC >= HEATED_BED_MIN_TEMP)
+    {
+        waitForHeatedBedTemperature();
+    }
+#endif // HAVE_HEATED_BED
+
+    for(uint8_t i=0; i<NUM_EXTRUDER; i++)
+    {
+        // a heater which has been switched off in the meantime is not waited for
+        if((pending & (1 << i)) && extruder[i].tempControl.targetTemperatureC >= EXTRUDER_MIN_TEMP)
+        {
+            waitForExtruderTemperature(&extruder[i]);
+        }
+    }
+
+} // waitForPendingHeatUp
+#endif // FEATURE_ASYNC_HEATUP
+
 void Commands::printCurrentPosition()
 {
     float x,y,z;
@@ -250,11 +406,17 @@ void Commands::printCurrentPosition()
 } // printCurrentPosition
 
 
-void Commands::printTemperatures(bool showRaw)
+bool Commands::printTemperatures(bool showRaw)
 {
     static millis_t lastTemperatureSignal = 0;
     millis_t now = HAL::timeInMilliseconds();
     if( (now - lastTemperatureSignal) > 1000 ){
+        if( !Com::beginLowPriority() )
+        {
+            // the serial output buffer is almost full - the current temperatures are sent with one of the next calls
+            Com::endLowPriority();
+            return false;
+        }
         lastTemperatureSignal = now;
 
 
@@ -315,11 +477,148 @@ void Commands::printTemperatures(bool showRaw)
         Com::printF(Com::tSpaceAtColon,0); //Ziel ^^, nein ich halte mich nur an die PWM-Syntax
 #endif //FEATURE_PRINT_PRESSURE
 
+#if FEATURE_HEATUP_ETA
+        // estimated time until the extruders 0..n and the heated bed reach their target temperatures [s], 0 = reached or no target, -1 = not known yet
+        Com::printF(Com::tSpaceETAColon,(int)tempController[0]->heatUpEta);
+        for(uint8_t i=1; i<NUM_TEMPERATURE_LOOPS; i++)
+        {
+            Com::printF(Com::tComma,(int)tempController[i]->heatUpEta);
+        }
+#endif // FEATURE_HEATUP_ETA
+
     Com::println();
+    Com::endLowPriority();
+    return true;
     }
+    return false;
 } // printTemperatures
 
 
+#if FEATURE_ADAPTIVE_TEMPERATURE_REPORT
+static void writeTemperatureFrameByte(uint8_t value, uint8_t& sum1, uint8_t& sum2)
+{
+    HAL::serialWriteByte((char)value);
+
+    // fletcher-16 checksum, like the one of the binary g-code protocol
+    sum1 = (uint8_t)(((uint16_t)sum1 + value) % 255);
+    sum2 = (uint8_t)(((uint16_t)sum2 + sum1) % 255);
+
+} // writeTemperatureFrameByte
+
+
+/** \brief Sends a binary temperature frame. The frame consists of TEMPERATURE_FRAME_START, TEMPERATURE_FRAME_TYPE, the number of temperature loops, 5 bytes per
+temperature loop (extruders 0..n, heated bed) and the fletcher-16 checksum of all bytes after TEMPERATURE_FRAME_START. Each loop consists of the current temperature [0.1 °C] and
+the target temperature [°C] as little endian int16 and of the heater output [0 ... 255]. Returns false if the frame was dropped because the serial output buffer is almost full. */
+static bool printTemperatureFrame(const int16_t* temperatures, const int16_t* targets, const uint8_t* outputs)
+{
+    uint8_t sum1 = 0;
+    uint8_t sum2 = 0;
+
+
+    if( !Com::beginLowPriority() )
+    {
+        Com::endLowPriority();
+        return false;
+    }
+
+    HAL::serialWriteByte((char)TEMPERATURE_FRAME_START);
+    writeTemperatureFrameByte(TEMPERATURE_FRAME_TYPE,sum1,sum2);
+    writeTemperatureFrameByte(NUM_TEMPERATURE_LOOPS,sum1,sum2);
+    for(uint8_t i=0; i<NUM_TEMPERATURE_LOOPS; i++)
+    {
+        writeTemperatureFrameByte((uint8_t)temperatures[i],sum1,sum2);
+        writeTemperatureFrameByte((uint8_t)((uint16_t)temperatures[i] >> 8),sum1,sum2);
+        writeTemperatureFrameByte((uint8_t)targets[i],sum1,sum2);
+        writeTemperatureFrameByte((uint8_t)((uint16_t)targets[i] >> 8),sum1,sum2);
+        writeTemperatureFrameByte(outputs[i],sum1,sum2);
+    }
+    HAL::serialWriteByte((char)sum1);
+    HAL::serialWriteByte((char)sum2);
+
+    Com::endLowPriority();
+    return true;
+
+} // printTemperatureFrame
+#endif // FEATURE_ADAPTIVE_TEMPERATURE_REPORT
+
+
+/** \brief Sends the periodic temperature report. In the adaptive report modes, the report is skipped as long as no temperature, target temperature or heater output
+has changed noticeably since the last report and TEMPERATURE_REPORT_MAX_INTERVAL has not elapsed. */
+void Commands::reportTemperatures()
+{
+#if FEATURE_ADAPTIVE_TEMPERATURE_REPORT
+    static int16_t  reportedTemperature[NUM_TEMPERATURE_LOOPS];
+    static int16_t  reportedTarget[NUM_TEMPERATURE_LOOPS];
+    static uint8_t  reportedOutput[NUM_TEMPERATURE_LOOPS];
+    static millis_t lastReport = 0;
+    int16_t         temperature[NUM_TEMPERATURE_LOOPS];
+    int16_t         target[NUM_TEMPERATURE_LOOPS];
+    uint8_t         output[NUM_TEMPERATURE_LOOPS];
+    millis_t        now     = HAL::timeInMilliseconds();
+    bool            changed = false;
+    bool            sent;
+
+
+    if( temperatureReportMode == TEMPERATURE_REPORT_FIXED )
+    {
+        printTemperatures();
+        return;
+    }
+    if( (now - lastReport) < TEMPERATURE_REPORT_MIN_INTERVAL )
+    {
+        return;
+    }
+
+    for(uint8_t i=0; i<NUM_TEMPERATURE_LOOPS; i++)
+    {
+        TemperatureController* act = tempController[i];
+
+        temperature[i] = (int16_t)(act->currentTemperatureC * 10.0f);
+        target[i]      = (int16_t)act->targetTemperatureC;
+        output[i]      = pwm_pos[act->pwmIndex];
+
+        if( abs(temperature[i] - reportedTemperature[i]) >= TEMPERATURE_REPORT_THRESHOLD ||
+            target[i] != reportedTarget[i] ||
+            abs((int16_t)output[i] - (int16_t)reportedOutput[i]) >= TEMPERATURE_REPORT_OUTPUT_THRESHOLD )
+        {
+            changed = true;
+        }
+    }
+
+    if( !changed && (now - lastReport) < TEMPERATURE_REPORT_MAX_INTERVAL )
+    {
+        return;
+    }
+
+    if( temperatureReportMode == TEMPERATURE_REPORT_BINARY )
+    {
+        sent = printTemperatureFrame(temperature,target,output);
+    }
+    else
+    {
+        sent = printTemperatures();
+    }
+
+    if( !sent )
+    {
+        // the report has been dropped - it is sent again with one of the next calls
+        return;
+    }
+
+    for(uint8_t i=0; i<NUM_TEMPERATURE_LOOPS; i++)
+    {
+        reportedTemperature[i] = temperature[i];
+        reportedTarget[i]      = target[i];
+        reportedOutput[i]      = output[i];
+    }
+    lastReport = now;
+#else
+    printTemperatures();
+#endif // FEATURE_ADAPTIVE_TEMPERATURE_REPORT
+
+} // reportTemperatures
+
+
 void Commands::changeFeedrateMultiply(int factor)
 {
     if(factor<25) factor=25;
@@ -544,6 +843,27 @@ void Commands::executeGCode(GCode *com)
         }
     }
 #endif
+
+#if FEATURE_ASYNC_HEATUP
+    if(pendingHeatUp && com->needsTemperature())
+    {
+        waitForPendingHeatUp();
+    }
+#endif // FEATURE_ASYNC_HEATUP
+
+#if FEATURE_FAST_MOVES
+    if(com->isPlainMove() && !Printer::relativeCoordinateMode && !Printer::unitIsInches && !Printer::debugDryrun())
+    {
+        // plain G0/G1 moves are supported in all operating modes, so we can enqueue them without the generic dispatch
+        if(isMovingAllowed(com->G ? PSTR("G1") : PSTR("G0")) && Printer::setDestinationStepsFromPlainMove(com))
+        {
+            PrintLine::prepareQueueMove(ALWAYS_CHECK_ENDSTOPS,true);
+        }
+        previousMillisCmd = HAL::timeInMilliseconds();
+        return;
+    }
+#endif // FEATURE_FAST_MOVES
+
     if(com->hasG())
     {
         switch(com->G)
@@ -933,6 +1253,14 @@ void Commands::executeGCode(GCode *com)
             case 21: // M21 - init SD card
             {
                 sd.mount();
+
+#if FEATURE_SD_NONBLOCKING_MOUNT
+                // the card is mounted within the loop actions, M21 is finished when the mount has ended
+                while( sd.mountState != SD_MOUNT_IDLE )
+                {
+                    Printer::defaultLoopActions();
+                }
+#endif // FEATURE_SD_NONBLOCKING_MOUNT
                 break;
             }
             case 22: // M22 - release SD card
@@ -1108,78 +1436,21 @@ void Commands::executeGCode(GCode *com)
                     }
                     else if ( !ExtruderTemp ) break;
                     ExtruderTemp = 1;
-                    g_uStartOfIdle = 0;
-                    UI_STATUS_UPD(UI_TEXT_HEATING_EXTRUDER);
-
-#if FEATURE_EXTENDED_BUTTONS || FEATURE_PAUSE_PRINTING
-                    Printer::waitMove = 1;
-#endif // FEATURE_EXTENDED_BUTTONS || FEATURE_PAUSE_PRINTING
 
                     Commands::waitUntilEndOfAllMoves();
                     Extruder *actExtruder = Extruder::current;
                     if(com->hasT() && com->T<NUM_EXTRUDER) actExtruder = &extruder[com->T];
                     if (com->hasS()) Extruder::setTemperatureForExtruder(com->S,actExtruder->id,com->hasF() && com->F>0);
 
-                    if(fabs(actExtruder->tempControl.targetTemperatureC - actExtruder->tempControl.currentTemperatureC) < TEMP_TOLERANCE)
-                    {
-                        // we are already in range
-
-#if FEATURE_EXTENDED_BUTTONS || FEATURE_PAUSE_PRINTING
-                        Printer::waitMove = 0;
-#endif // FEATURE_EXTENDED_BUTTONS || FEATURE_PAUSE_PRINTING
-
-                        break;
-                    }
-
-                    bool        dirRising   = actExtruder->tempControl.targetTemperature > actExtruder->tempControl.currentTemperature;
-                    millis_t    waituntil   = 0;
-
-#if RETRACT_DURING_HEATUP
-                    uint8_t     retracted = 0;
-#endif // RETRACT_DURING_HEATUP
-
-                    millis_t currentTime;
-                    do
-                    {
-                        currentTime = HAL::timeInMilliseconds();
-                        Commands::printTemperatures();                       
-                        Commands::checkForPeriodicalActions();
-                        GCode::keepAlive( WaitHeater );
-#if RETRACT_DURING_HEATUP
-                        if (actExtruder == Extruder::current && actExtruder->waitRetractUnits > 0 && !retracted && dirRising && actExtruder->tempControl.currentTemperatureC > actExtruder->waitRetractTemperature)
-                        {
-                            PrintLine::moveRelativeDistanceInSteps(0,0,0,-actExtruder->waitRetractUnits * Printer::axisStepsPerMM[E_AXIS],actExtruder->maxFeedrate,false,false);
-                            retracted = 1;
-                        }
-#endif // RETRACT_DURING_HEATUP
-
-                        if((waituntil == 0 &&
-                            (dirRising ? actExtruder->tempControl.currentTemperatureC >= actExtruder->tempControl.targetTemperatureC-TEMP_TOLERANCE : actExtruder->tempControl.currentTemperatureC <= actExtruder->tempControl.targetTemperatureC+TEMP_TOLERANCE))
-#if defined(TEMP_HYSTERESIS) && TEMP_HYSTERESIS>=1
-                            || (waituntil!=0 && (abs(actExtruder->tempControl.currentTemperatureC - actExtruder->tempControl.targetTemperatureC))>TEMP_HYSTERESIS)
-#endif // #if defined(TEMP_HYSTERESIS) && TEMP_HYSTERESIS>=1
-                          )
-                        {
-                            waituntil = currentTime+1000UL*(millis_t)actExtruder->watchPeriod; // now wait for temp. to stabalize
-                        }
-                    }
-                    while(waituntil==0 || (waituntil!=0 && (millis_t)(waituntil-currentTime)<2000000000UL));
-
-#if RETRACT_DURING_HEATUP
-                    if (retracted && actExtruder==Extruder::current)
-                    {
-                        PrintLine::moveRelativeDistanceInSteps(0,0,0,actExtruder->waitRetractUnits * Printer::axisStepsPerMM[E_AXIS],actExtruder->maxFeedrate,false,false);
-                    }
-#endif // RETRACT_DURING_HEATUP
+#if FEATURE_ASYNC_HEATUP
+                    // the extruder heats up in the background, the next command which needs the temperature waits for it
+                    pendingHeatUp |= 1 << actExtruder->id;
+                    UI_STATUS_UPD(UI_TEXT_HEATING_EXTRUDER);
+#else
+                    waitForExtruderTemperature(actExtruder);
+#endif // FEATURE_ASYNC_HEATUP
 #endif // NUM_EXTRUDER>0
-
-#if FEATURE_EXTENDED_BUTTONS || FEATURE_PAUSE_PRINTING
-                    Printer::waitMove = 0;
-#endif // FEATURE_EXTENDED_BUTTONS || FEATURE_PAUSE_PRINTING
                 }
-
-                g_uStartOfIdle    = HAL::timeInMilliseconds();
-                previousMillisCmd = HAL::timeInMilliseconds();
                 break;
             }
             case 190: // M190 - Wait bed for heater to reach target.
@@ -1197,46 +1468,28 @@ void Commands::executeGCode(GCode *com)
                     }
                     else if ( !BedTemp ) break;
                     BedTemp = 1;
-                    g_uStartOfIdle = 0;
-                    UI_STATUS_UPD(UI_TEXT_HEATING_BED);
-
-#if FEATURE_EXTENDED_BUTTONS || FEATURE_PAUSE_PRINTING
-                    Printer::waitMove = 1;
-#endif // FEATURE_EXTENDED_BUTTONS || FEATURE_PAUSE_PRINTING
 
                     Commands::waitUntilEndOfAllMoves();
                     if (com->hasS()) Extruder::setHeatedBedTemperature(com->S,com->hasF() && com->F>0);
 
-                    if( fabs(heatedBedController.currentTemperatureC-heatedBedController.targetTemperatureC) < TEMP_TOLERANCE )
-                    {
-                        // we are already in range
-#if FEATURE_EXTENDED_BUTTONS || FEATURE_PAUSE_PRINTING
-                        Printer::waitMove = 0;
-#endif // FEATURE_EXTENDED_BUTTONS || FEATURE_PAUSE_PRINTING
-                        break;
-                    }
-
-                    while(heatedBedController.currentTemperatureC+TEMP_TOLERANCE < heatedBedController.targetTemperatureC)
-                    {
-                        Commands::printTemperatures();
-                        Commands::checkForPeriodicalActions();
-                        GCode::keepAlive( WaitHeater );
-                    }
-
-#if FEATURE_EXTENDED_BUTTONS || FEATURE_PAUSE_PRINTING
-                    Printer::waitMove = 0;
-#endif // FEATURE_EXTENDED_BUTTONS || FEATURE_PAUSE_PRINTING
+#if FEATURE_ASYNC_HEATUP
+                    // the heat bed heats up in the background, the next command which needs the temperature waits for it
+                    pendingHeatUp |= 1 << NUM_EXTRUDER;
+                    UI_STATUS_UPD(UI_TEXT_HEATING_BED);
+#else
+                    waitForHeatedBedTemperature();
+#endif // FEATURE_ASYNC_HEATUP
 #endif // HAVE_HEATED_BED
                 }
-
-                g_uStartOfIdle    = HAL::timeInMilliseconds();
-                previousMillisCmd = HAL::timeInMilliseconds();
                 break;
             }
             case 116: // M116 - Wait for temperatures to reach target temperature
             {
                 if( isSupportedMCommand( com->M, OPERATING_MODE_PRINT ) )
                 {
+#if FEATURE_ASYNC_HEATUP
+                    pendingHeatUp = 0;  // M116 waits for all heaters
+#endif // FEATURE_ASYNC_HEATUP
                     if(Printer::debugDryrun()) break;
                     {
                         bool allReached = false;
@@ -1924,6 +2177,11 @@ void Commands::executeGCode(GCode *com)
     else if(com->hasT())      // Process T code
     {
         Commands::waitUntilEndOfAllMoves();
+
+#if SDSUPPORT && FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
+        if( sd.sdmode ) sd.toolChangeExecuted( com->T );
+#endif // SDSUPPORT && FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
+
         Extruder::selectExtruderById(com->T);
     }
     else
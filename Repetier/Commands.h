@@ -28,8 +28,18 @@ public:
     static void waitUntilEndOfAllMoves();
     static void waitUntilEndOfAllBuffers(unsigned int maxcodes = 0);
     static void waitUntilEndOfZOS();
+    static void waitForExtruderTemperature(Extruder *actExtruder);
+    static void waitForHeatedBedTemperature();
+#if FEATURE_ASYNC_HEATUP
+    static void waitForPendingHeatUp();
+    static uint8_t pendingHeatUp;   ///< Heaters started via M109/M190 which have not been waited for yet. Bit 0-5 = Extruder, bit NUM_EXTRUDER = Heated bed
+#endif // FEATURE_ASYNC_HEATUP
     static void printCurrentPosition();
-    static void printTemperatures(bool showRaw = false);
+    static bool printTemperatures(bool showRaw = false);
+    static void reportTemperatures();
+#if FEATURE_ADAPTIVE_TEMPERATURE_REPORT
+    static uint8_t temperatureReportMode;   ///< TEMPERATURE_REPORT_FIXED, TEMPERATURE_REPORT_ADAPTIVE or TEMPERATURE_REPORT_BINARY
+#endif // FEATURE_ADAPTIVE_TEMPERATURE_REPORT
 #if FAN_PIN>-1 && FEATURE_FAN_CONTROL
     static void setFanSpeed(int speed,bool wait); /// Set fan speed 0..255
     static void adjustFanFrequency(uint8_t speed_mode);
@@ -73,6 +73,9 @@ FSTRINGVALUE(Com::tSpaceChamber," C")
 FSTRINGVALUE(Com::tSpaceCAtColon," C@:")
 FSTRINGVALUE(Com::tSpaceAt," @")
 FSTRINGVALUE(Com::tSpaceBAtColon," B@:")
+#if FEATURE_HEATUP_ETA
+FSTRINGVALUE(Com::tSpaceETAColon," ETA:")
+#endif // FEATURE_HEATUP_ETA
 FSTRINGVALUE(Com::tSpaceRaw," RAW")
 FSTRINGVALUE(Com::tColon,":")
 FSTRINGVALUE(Com::tSlash,"/")
@@ -150,8 +153,14 @@ FSTRINGVALUE(Com::tAPIDsimpleP," P")
 FSTRINGVALUE(Com::tAPIDKp," Kp: ")
 FSTRINGVALUE(Com::tAPIDKi," Ki: ")
 FSTRINGVALUE(Com::tAPIDKd," Kd: ")
+FSTRINGVALUE(Com::tAPIDStepResponse," Step response model")
+FSTRINGVALUE(Com::tAPIDHeatRate," heat rate [°C/s]: ")
+FSTRINGVALUE(Com::tAPIDLossRate," loss rate [1/s]: ")
+FSTRINGVALUE(Com::tAPIDDeadTime," dead time [s]: ")
+FSTRINGVALUE(Com::tAPIDDriveMax," drive max: ")
 FSTRINGVALUE(Com::tAPIDFailedHigh,"PID Autotune failed! Temperature to high")
 FSTRINGVALUE(Com::tAPIDFailedTimeout,"PID Autotune failed! timeout")
+FSTRINGVALUE(Com::tAPIDFailedModel,"PID Autotune failed! no usable step response")
 FSTRINGVALUE(Com::tAPIDFinished,"PID Autotune finished ! Place the Kp, Ki and Kd constants in the Configuration.h or EEPROM")
 FSTRINGVALUE(Com::tMTEMPColon,"MTEMP:")
 FSTRINGVALUE(Com::tHeatedBed,"heated bed")
@@ -232,24 +241,30 @@ FSTRINGVALUE(Com::tEPROPSMoveAfter,"OPS move after x% retract [%]")
 FSTRINGVALUE(Com::tEPROPSMinDistance,"OPS min. distance for fil. retraction [mm]")
 FSTRINGVALUE(Com::tEPROPSRetractionLength,"OPS retraction length [mm]")
 FSTRINGVALUE(Com::tEPROPSRetractionBacklash,"OPS retraction backlash [mm]")
-FSTRINGVALUE(Com::tEPRBedHeatManager,"Bed Heat Manager [0-3]")
+FSTRINGVALUE(Com::tEPRBedHeatManager,"Bed Heat Manager [0-4]")
 FSTRINGVALUE(Com::tEPRBedPIDDriveMax,"Bed PID I-drive max")
 FSTRINGVALUE(Com::tEPRBedPIDDriveMin,"Bed PID I-drive min")
 FSTRINGVALUE(Com::tEPRBedPGain,"Bed PID P-gain")
 FSTRINGVALUE(Com::tEPRBedIGain,"Bed PID I-gain")
 FSTRINGVALUE(Com::tEPRBedDGain,"Bed PID D-gain")
 FSTRINGVALUE(Com::tEPRBedPISMaxValue,"Bed max power value [0-255]")
+FSTRINGVALUE(Com::tEPRBedModelHeatRate,"Bed model heat rate [C/s]")
+FSTRINGVALUE(Com::tEPRBedModelLossRate,"Bed model loss rate [1/s]")
+FSTRINGVALUE(Com::tEPRBedModelDeadTime,"Bed model dead time [s]")
 FSTRINGVALUE(Com::tEPRStepsPerMM,"steps per mm")
 FSTRINGVALUE(Com::tEPRMaxFeedrate,"max. feedrate [mm/s]")
 FSTRINGVALUE(Com::tEPRStartFeedrate,"start feedrate [mm/s]")
 FSTRINGVALUE(Com::tEPRAcceleration,"acceleration [mm/s^2]")
-FSTRINGVALUE(Com::tEPRHeatManager,"heat manager [0-3]")
+FSTRINGVALUE(Com::tEPRHeatManager,"heat manager [0-4]")
 FSTRINGVALUE(Com::tEPRDriveMax,"PID I-drive max")
 FSTRINGVALUE(Com::tEPRDriveMin,"PID I-drive min")
 FSTRINGVALUE(Com::tEPRPGain,"PID P-gain/dead-time")
 FSTRINGVALUE(Com::tEPRIGain,"PID I-gain")
 FSTRINGVALUE(Com::tEPRDGain,"PID D-gain")
 FSTRINGVALUE(Com::tEPRPIDMaxValue,"max power value [0-255]")
+FSTRINGVALUE(Com::tEPRModelHeatRate,"model heat rate [C/s]")
+FSTRINGVALUE(Com::tEPRModelLossRate,"model loss rate [1/s]")
+FSTRINGVALUE(Com::tEPRModelDeadTime,"model dead time [s]")
 FSTRINGVALUE(Com::tEPRBedsensorType,"Bed Temp. SensorType [0=Cfg,3=Conrad,..]")
 FSTRINGVALUE(Com::tEPRsensorType,"Temp. SensorType [0=Cfg,3=V2,8=E3D,..]")
 FSTRINGVALUE(Com::tEPRXOffset,"X-offset [mm]")
@@ -77,6 +77,9 @@ public:
     FSTRINGVAR(tSpaceRaw)
     FSTRINGVAR(tSpaceAt)
     FSTRINGVAR(tSpaceBAtColon)
+#if FEATURE_HEATUP_ETA
+    FSTRINGVAR(tSpaceETAColon)
+#endif // FEATURE_HEATUP_ETA
     FSTRINGVAR(tColon)
     FSTRINGVAR(tSpeedMultiply)
     FSTRINGVAR(tFlowMultiply)
@@ -150,8 +153,14 @@ public:
     FSTRINGVAR(tAPIDKp)
     FSTRINGVAR(tAPIDKi)
     FSTRINGVAR(tAPIDKd)
+    FSTRINGVAR(tAPIDStepResponse)
+    FSTRINGVAR(tAPIDHeatRate)
+    FSTRINGVAR(tAPIDLossRate)
+    FSTRINGVAR(tAPIDDeadTime)
+    FSTRINGVAR(tAPIDDriveMax)
     FSTRINGVAR(tAPIDFailedHigh)
     FSTRINGVAR(tAPIDFailedTimeout)
+    FSTRINGVAR(tAPIDFailedModel)
     FSTRINGVAR(tAPIDFinished)
     FSTRINGVAR(tMTEMPColon)
     FSTRINGVAR(tHeatedBed)
@@ -247,6 +256,9 @@ public:
     FSTRINGVAR(tEPRBedIGain)
     FSTRINGVAR(tEPRBedDGain)
     FSTRINGVAR(tEPRBedPISMaxValue)
+    FSTRINGVAR(tEPRBedModelHeatRate)
+    FSTRINGVAR(tEPRBedModelLossRate)
+    FSTRINGVAR(tEPRBedModelDeadTime)
     FSTRINGVAR(tEPRStepsPerMM)
     FSTRINGVAR(tEPRMaxFeedrate)
     FSTRINGVAR(tEPRStartFeedrate)
@@ -258,6 +270,9 @@ public:
     FSTRINGVAR(tEPRIGain)
     FSTRINGVAR(tEPRDGain)
     FSTRINGVAR(tEPRPIDMaxValue)
+    FSTRINGVAR(tEPRModelHeatRate)
+    FSTRINGVAR(tEPRModelLossRate)
+    FSTRINGVAR(tEPRModelDeadTime)
     FSTRINGVAR(tEPRBedsensorType)
     FSTRINGVAR(tEPRsensorType)
     FSTRINGVAR(tEPRXOffset)
@@ -380,6 +395,14 @@ public:
     static void printFloat(float number, uint8_t digits, bool komma_as_dot=false);
     static inline void println() {HAL::serialWriteByte('\r');HAL::serialWriteByte('\n');}
 
+#if FEATURE_SERIAL_NON_BLOCKING && !defined(EXTERNALSERIAL)
+    static inline bool beginLowPriority() {return RFSERIAL.beginLowPriority();}
+    static inline void endLowPriority() {RFSERIAL.endLowPriority();}
+#else
+    static inline bool beginLowPriority() {return true;}
+    static inline void endLowPriority() {}
+#endif // FEATURE_SERIAL_NON_BLOCKING && !defined(EXTERNALSERIAL)
+
 }; // Com
 
 
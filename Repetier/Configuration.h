@@ -166,6 +166,14 @@ to print an object two times at the speed of one. Works only with dual extruder
 /** \brief Enables/disables the support for G2/G3 arc commands */
 #define FEATURE_ARC_SUPPORT                 1                                                   // 1 = on, 0 = off
 
+/** \brief Enables/disables the fast path for plain G0/G1 commands (only N/X/Y/Z/E/F in absolute mm coordinates), which bypasses the generic G-Code dispatch */
+#define FEATURE_FAST_MOVES                  1                                                   // 1 = on, 0 = off
+
+/** \brief Enables/disables the heat-up in the background. M109/M190 only start the heating, the next command which needs the temperature
+(extrusion, z-offset scan, M116) waits for it, so that homing and positioning run while the heaters heat up.
+The G-Code behaves differently than before (M109/M190 return at once), so this is off by default. */
+#define FEATURE_ASYNC_HEATUP                0                                                   // 1 = on, 0 = off
+
 /** \brief Enables/disables the beeper */
 #define FEATURE_BEEPER                      1                                                   // 1 = on, 0 = off
 
@@ -445,7 +453,7 @@ If you have a PTC thermistor instead of a NTC thermistor, keep the adc values in
 #define NUM_TEMPS_USERTHERMISTOR2           0
 #define USER_THERMISTORTABLE2               {}
 
-/** \brief If defined, creates a thermistor table at startup.
+/** \brief If defined, creates a thermistor table at compile time. The table is stored in the flash memory and has one entry for every 32 raw values.
 
 If you don't feel like computing the table on your own, you can use this generic method. It is
 a simple approximation which may be not as accurate as a good table computed from the reference
@@ -522,10 +530,6 @@ See http://reprap.org/wiki/MeasuringThermistorBeta for more details.
 /** \brief Supply voltage to ADC, can be changed by setting ANALOG_REF below to different value. */
 #define GENERIC_THERM_VREF                  5
 
-/** \brief Number of entries in generated table. One entry takes 4 bytes. Higher number of entries increase computation time too.
-Value is used for all generic tables created. */
-#define GENERIC_THERM_NUM_ENTRIES           33
-
 
 // ##########################################################################################
 // ##   duplicate motor drivers
@@ -569,6 +573,117 @@ instead of driving both with a single stepper. The same works for the other axis
 #define LONG_FILENAME_LENGTH                (13*MAX_VFAT_ENTRIES+1)
 #define SD_MAX_FOLDER_DEPTH                 4
 
+/** \brief Keeps an index of the directory which is shown by the file menu of the display, so that scrolling through large folders does not read the directory from its beginning again and again.
+The index is dropped whenever a file or folder is created, removed or renamed. It needs 3 bytes of RAM per entry, so this is off by default. */
+#define FEATURE_SD_DIRECTORY_INDEX          0                                                   // 1 = on, 0 = off
+
+#if FEATURE_SD_DIRECTORY_INDEX
+/** \brief Number of index entries. In larger folders, only every 2nd, 4th, ... entry is indexed and the entries in between are read from the directory. */
+#define SD_DIRECTORY_INDEX_SIZE             32
+#endif // FEATURE_SD_DIRECTORY_INDEX
+
+/** \brief Mounts the SD card step by step within the main loop instead of waiting for the complete initialization of the card, so that inserting a card (or M21) does not stall the heaters, the display and the serial communication.
+The mount state needs about 20 bytes of RAM, so this is off by default. */
+#define FEATURE_SD_NONBLOCKING_MOUNT        0                                                   // 1 = on, 0 = off
+
+#if FEATURE_SD_NONBLOCKING_MOUNT
+/** \brief Time between the dummy initialization and the actual initialization of the card [ms] */
+#define SD_MOUNT_DUMMY_INIT_DELAY           50
+#endif // FEATURE_SD_NONBLOCKING_MOUNT
+
+/** \brief Keeps a hash index of the file names of the last searched folder, so that opening a file by name (e.g. M23) does not compare the name with every file of the folder.
+The index needs about 200 bytes of RAM, so this is off by default. */
+#define FEATURE_SD_NAME_INDEX               0                                                   // 1 = on, 0 = off
+
+#if FEATURE_SD_NAME_INDEX
+/** \brief Number of slots of the hash index (3 bytes of RAM each). In folders with more files, the names behind the indexed ones are searched as before. */
+#define SD_NAME_INDEX_SIZE                  64
+#endif // FEATURE_SD_NAME_INDEX
+
+/** \brief Keeps the runs of contiguous clusters which have been found in the FAT, so that reading and seeking within large files does not need to read the FAT again.
+Each run needs 8 bytes of RAM, so this is off by default. */
+#define FEATURE_SD_EXTENT_CACHE             0                                                   // 1 = on, 0 = off
+
+#if FEATURE_SD_EXTENT_CACHE
+/** \brief Number of cluster runs which are kept. A file which has been written without fragmentation needs one run. */
+#define SD_EXTENT_CACHE_SIZE                4
+#endif // FEATURE_SD_EXTENT_CACHE
+
+/** \brief Reads the file which is printed from the SD card via an open multi-block transfer (CMD18) instead of one single-block command (CMD17) per 512 bytes.
+The transfer state of the card needs 5 bytes of RAM, so this is off by default. */
+#define FEATURE_SD_STREAMING_READ           0                                                   // 1 = on, 0 = off
+
+/** \brief Uploads (M28) into contiguous cluster runs which are reserved in advance, so that the file is written via multi-block transfers (CMD25) and the FAT is touched only once per run.
+The upload and the transfer state of the card need about 10 bytes of RAM, so this is off by default. */
+#define FEATURE_SD_FAST_UPLOAD              0                                                   // 1 = on, 0 = off
+
+#if FEATURE_SD_FAST_UPLOAD
+/** \brief Size of the cluster runs which are reserved for an upload [KB]. The first run is reserved at M28 and the next one whenever the upload reaches the end of a run, the search for a free run checks at most 16 times its size. Unused clusters are released at M29, the clusters of an interrupted upload are released when the file is opened for write or the card is mounted. */
+#define SD_FAST_UPLOAD_PREALLOCATION        256
+#endif // FEATURE_SD_FAST_UPLOAD
+
+/** \brief Allows to upload a file as raw data blocks with sequence number and CRC (M3416), which are acknowledged in windows instead of line by line. Other G-Code is ignored during the upload, except M112 between two blocks.
+The block buffer needs about 80 bytes of RAM, so this is off by default. */
+#define FEATURE_SD_BLOCK_UPLOAD             0                                                   // 1 = on, 0 = off
+
+#if FEATURE_SD_BLOCK_UPLOAD
+/** \brief Maximal payload of one data block [bytes] */
+#define SD_BLOCK_UPLOAD_SIZE                56
+
+/** \brief Number of data blocks which the host may send ahead of the last acknowledgement, the firmware acknowledges every half window. All blocks of one window must fit into the serial receive buffer, because the firmware does not read from it while it writes to the SD card. */
+#define SD_BLOCK_UPLOAD_WINDOW              2
+
+/** \brief Time without data after which an incomplete block is dropped and the missing block is requested again [ms] */
+#define SD_BLOCK_FRAME_TIMEOUT              500
+
+/** \brief Time without data after which the block upload is aborted [ms] */
+#define SD_BLOCK_UPLOAD_TIMEOUT             10000
+#endif // FEATURE_SD_BLOCK_UPLOAD
+
+/** \brief Allows to convert an ASCII G-Code file into a binary sibling file (M3400), which is used automatically by SDCard::selectFile() as long as it is up to date.
+The conversion needs about 190 bytes of RAM, so this is off by default. */
+#define FEATURE_SD_BINARY_CACHE             0                                                   // 1 = on, 0 = off
+
+#if FEATURE_SD_BINARY_CACHE
+/** \brief File extension of the binary sibling file */
+#define SD_BINARY_CACHE_EXTENSION           ".bgc"
+
+/** \brief Size of the header of the binary sibling file, the header identifies the size and the modification time of the source file */
+#define SD_BINARY_CACHE_HEADER_SIZE         12
+
+/** \brief Size of the buffer which collects the binary commands before they are written to the SD card */
+#define SD_BINARY_CACHE_BUFFER_SIZE         128
+
+/** \brief Maximal number of source bytes which are processed within one call of SDCard::convertStep() */
+#define SD_BINARY_CACHE_BYTES_PER_STEP      64
+#endif // FEATURE_SD_BINARY_CACHE
+
+/** \brief Scans the selected file (M23) while the printer is idle: CRC32 of the file, number of commands, range of the X/Y/Z positions and total extrusion, see M3417.
+The scan covers files which the host selects before it starts the print, a print which is started from the display begins at once and pauses the scan.
+The scan state and its second file handle need about 240 bytes of RAM, so this is off by default. */
+#define FEATURE_SD_PREFLIGHT_SCAN           0                                                   // 1 = on, 0 = off
+
+#if FEATURE_SD_PREFLIGHT_SCAN
+/** \brief Maximal number of bytes which are scanned within one call of SDCard::preflightStep() */
+#define SD_PREFLIGHT_BYTES_PER_STEP         64
+#endif // FEATURE_SD_PREFLIGHT_SCAN
+
+/** \brief Allows to scan the SD file ahead of the print for the next tool change, to preheat the inactive extruder just in time and to drop the previous extruder to a standby temperature after the tool change.
+The scan reads each block of the file from the block cache when the print fetches it, so a tool change is found at most one block (512 bytes) before the print reads it.
+The scan needs about 40 bytes of RAM, so this is off by default. */
+#define FEATURE_TOOLCHANGE_PREHEAT          0                                                   // 1 = on, 0 = off
+
+#if FEATURE_TOOLCHANGE_PREHEAT
+/** \brief Target temperature of an extruder which is not used by the print at the moment */
+#define TOOLCHANGE_STANDBY_TEMPERATURE      150                                                 // [°C]
+
+/** \brief Additional time which is planned for the preheating of the next extruder */
+#define TOOLCHANGE_PREHEAT_MARGIN           10                                                  // [s]
+
+/** \brief Heat-up rate which is assumed for the preheating when no heater model is available */
+#define TOOLCHANGE_PREHEAT_HEAT_RATE        1.5f                                                // [°C/s]
+#endif // FEATURE_TOOLCHANGE_PREHEAT
+
 
 // ##########################################################################################
 // ##   configuration of the manual steps
@@ -613,6 +728,19 @@ Select the language to use.
 /** \brief Delay of start screen in milliseconds */
 #define UI_START_SCREEN_DELAY               1000
 
+/** \brief Enables/disables the differential update of the display. A shadow of the characters on the display is kept and only the changed characters are written.
+Large updates are spread over several calls, so that a single update does not block the command loop for longer than UI_MAX_BYTES_PER_UPDATE characters.
+displayCache serves as the shadow, the characters which shall be shown need UI_ROWS * UI_COLS bytes of RAM, so this is off by default. */
+#define FEATURE_DIFFERENTIAL_DISPLAY_UPDATE 0                                                   // 1 = on, 0 = off
+
+#if FEATURE_DIFFERENTIAL_DISPLAY_UPDATE
+/** \brief Maximal number of bytes (characters and cursor positions) which are written to the display within one call. One byte takes about UI_DELAYPERCHAR [us]. */
+#define UI_MAX_BYTES_PER_UPDATE             32
+
+/** \brief One row of the display is rewritten completely with every n-th refresh of the page, so that disturbed characters do not remain on the display. 0 = off */
+#define UI_SHADOW_REWRITE_INTERVAL          10
+#endif // FEATURE_DIFFERENTIAL_DISPLAY_UPDATE
+
 /** \brief Uncomment if you don't want automatic page switching. You can still switch the
 info pages with next/previous button/click-encoder */
 #define UI_DISABLE_AUTO_PAGESWITCH          true
@@ -840,6 +968,65 @@ need to increase this value. For one 6.8 Ohm heater 10 is ok. With two 6.8 Ohm h
 #define PID_CONTROL_DRIVE_MAX_LIMIT_FACTOR  10.0f //this was 10
 #define PID_CONTROL_DRIVE_MIN_LIMIT_FACTOR  -1.0f //this was 10 but -1.0 works well with drive max 100 and drive min 5. If this number is negative you get a real PID control, no PD+posI-control anymore.
 
+/** \brief Enables/disables the model based heater control (heat manager 4). It uses a first order thermal model with dead time of each heater
+to compute the heater output which holds the target temperature (feed-forward) and corrects the remaining error with a fixed point PI control.
+The model and the control state need 28 bytes of RAM per heater, so this is off by default. */
+#define FEATURE_HEAT_MODEL_CONTROL          0                                                   // 1 = on, 0 = off
+
+#if FEATURE_HEAT_MODEL_CONTROL
+/** \brief Default thermal model of the extruders: the heating rate at full heater power (heater power / heat capacity), the loss rate (loss coefficient / heat capacity)
+and the dead time between the heater and the temperature sensor. The model can be changed via M3413. */
+#define HEATER_MODEL_EXTRUDER_HEAT_RATE     2.5f                                                // [°C/s]
+#define HEATER_MODEL_EXTRUDER_LOSS_RATE     0.008f                                              // [1/s]
+#define HEATER_MODEL_EXTRUDER_DEAD_TIME     3.0f                                                // [s]
+
+/** \brief Default thermal model of the heat bed */
+#define HEATER_MODEL_BED_HEAT_RATE          0.25f                                               // [°C/s]
+#define HEATER_MODEL_BED_LOSS_RATE          0.0018f                                             // [1/s]
+#define HEATER_MODEL_BED_DEAD_TIME          12.0f                                               // [s]
+#endif // FEATURE_HEAT_MODEL_CONTROL
+
+/** \brief Ambient temperature which is assumed by the thermal model and by the step response identification of M303 */
+#define HEATER_MODEL_AMBIENT_TEMPERATURE    25                                                  // [°C]
+
+/** \brief Enables/disables the power budget of the heaters. When the heaters together would draw more than HEATER_POWER_BUDGET from the power supply, the heaters which hold
+their temperature get their power first, the remaining power is allocated to the heating heaters by priority and remaining error. Each heater can run at full power as long as the budget allows it.
+This is off by default, because the budget must be adapted to the power supply and to the heaters of the printer. */
+#define FEATURE_HEATER_POWER_BUDGET         0                                                   // 1 = on, 0 = off
+
+#if FEATURE_HEATER_POWER_BUDGET
+/** \brief Power of the power supply which is available for the heaters and the 24V FET outputs */
+#define HEATER_POWER_BUDGET                 260                                                 // [W]
+
+/** \brief Power of the heaters at full output */
+#define EXTRUDER_HEATER_POWER               40                                                  // [W]
+#define HEATED_BED_HEATER_POWER             180                                                 // [W]
+
+/** \brief Power which is reserved for each enabled 24V FET output */
+#define FET_OUTPUT_POWER                    24                                                  // [W]
+
+/** \brief Priority of the heaters while they heat up, 0 = highest priority. The heat bed has the highest priority by default, because it needs the longest time to heat up. */
+#define EXTRUDER_HEATER_PRIORITY            1
+#define HEATED_BED_HEATER_PRIORITY          0
+#endif // FEATURE_HEATER_POWER_BUDGET
+
+/** \brief Enables/disables the estimation of the time until each heater reaches its target temperature. The estimate is based on the observed heating rate and on the thermal model
+of the heater, it is reported in the temperature line (ETA:) and shown on the temperature page of the display. The estimate needs 10 bytes of RAM per heater, so this is off by default. */
+#define FEATURE_HEATUP_ETA                  0                                                   // 1 = on, 0 = off
+
+/** \brief Enables/disables the adaptive temperature report. The periodic temperature line is sent only in case a temperature changes by TEMPERATURE_REPORT_THRESHOLD, a target
+temperature changes or a heater output changes by TEMPERATURE_REPORT_OUTPUT_THRESHOLD, but at least every TEMPERATURE_REPORT_MAX_INTERVAL. Hosts can select the report mode via M3414,
+which includes a compact binary temperature frame without any float-to-ASCII conversions. The last reported values need about 20 bytes of RAM, so this is off by default. */
+#define FEATURE_ADAPTIVE_TEMPERATURE_REPORT 0                                                   // 1 = on, 0 = off
+
+#if FEATURE_ADAPTIVE_TEMPERATURE_REPORT
+#define TEMPERATURE_REPORT_MODE_DEFAULT     TEMPERATURE_REPORT_ADAPTIVE                         // TEMPERATURE_REPORT_FIXED, TEMPERATURE_REPORT_ADAPTIVE or TEMPERATURE_REPORT_BINARY
+#define TEMPERATURE_REPORT_MIN_INTERVAL     1000                                                // [ms]
+#define TEMPERATURE_REPORT_MAX_INTERVAL     5000                                                // [ms]
+#define TEMPERATURE_REPORT_THRESHOLD        5                                                   // [0.1 °C]
+#define TEMPERATURE_REPORT_OUTPUT_THRESHOLD 26                                                  // [0 ... 255]
+#endif // FEATURE_ADAPTIVE_TEMPERATURE_REPORT
+
 /** \brief Prevent extrusions longer then x mm for one command. This is especially important if you abort a print. Then the
 extrusion position might be at any value like 23344. If you then have an G1 E-2 it will roll back 23 meter! */
 #define EXTRUDE_MAXLENGTH                   100
@@ -860,6 +1047,20 @@ Uncomment define to force the temperature into the range for given watchperiod.
 
 /** \brief Build median from 2^ANALOG_INPUT_SAMPLE samples */
 #define ANALOG_INPUT_SAMPLE                 5
+
+/** \brief Enables/disables the sampling of the analog inputs within the ADC conversion complete interrupt. When disabled, the analog inputs are sampled within the PWM interrupt.
+The schedule, the filter and the statistics need about 40 bytes of RAM, so this is off by default. */
+#define FEATURE_ADC_INTERRUPT               0                                                   // 1 = on, 0 = off
+
+/** \brief Enables/disables the table driven software PWM of the heaters. When enabled, the switching edges of all heaters are precomputed whenever a duty cycle changes and the PWM interrupt applies each edge with one write per port.
+The edge tables need about 40 bytes of RAM, so this is off by default. */
+#define FEATURE_PWM_PORT_TABLE              0                                                   // 1 = on, 0 = off
+
+/** \brief Number of times the analog inputs of the extruders are sampled per round in which the other analog inputs (heat bed, reserve) are sampled once */
+#define ANALOG_INPUT_EXTRUDER_WEIGHT        2
+
+/** \brief Weight of the IIR filter which is applied to the decimated analog values, each new value contributes with 1/2^ANALOG_INPUT_FILTER_SHIFT. 0 disables the filter, the maximum is 4. */
+#define ANALOG_INPUT_FILTER_SHIFT           2
 #define ANALOG_REF_AREF                     0
 #define ANALOG_REF_AVCC                     _BV(REFS0)
 #define ANALOG_REF_INT_1_1                  _BV(REFS1)
@@ -874,9 +1075,40 @@ Uncomment define to force the temperature into the range for given watchperiod.
 #define N_ARC_CORRECTION                    25
 
 /** \brief Communication speed.
-Overridden if EEPROM activated. */
+Overridden if EEPROM activated. At 16 MHz, 250000, 500000 and 1000000 baud are reached exactly, 115200 baud deviates by 2.1%. */
 #define BAUDRATE                            115200
 
+/** \brief Allows the host to switch the baudrate via M3411 (e.g. to 250000, 500000 or 1000000 baud). The firmware falls back to the previous baudrate
+in case no valid command is received or too many communication errors occur within the probation time after the switch.
+The switching and the link statistics need 33 bytes of RAM, so this is off by default. */
+#define FEATURE_BAUDRATE_SWITCHING          0                                                   // 1 = on, 0 = off
+
+#if FEATURE_BAUDRATE_SWITCHING
+/** \brief Time after a switch of the baudrate within which the host must send at least one valid command [ms] */
+#define SERIAL_BAUDRATE_PROBATION_TIME      5000
+
+/** \brief Number of checksum errors and resend requests within the probation time which cause the fallback to the previous baudrate */
+#define SERIAL_BAUDRATE_FALLBACK_ERRORS     10
+
+/** \brief Maximal allowed deviation between the requested and the really reached baudrate [per mille] */
+#define SERIAL_BAUDRATE_MAX_DEVIATION       30
+#endif // FEATURE_BAUDRATE_SWITCHING
+
+/** \brief Size of the serial output buffer [bytes], must be a power of 2 and not larger than 256. The buffer is allocated in RAM. */
+#define SERIAL_OUTPUT_BUFFER_SIZE           64
+
+/** \brief Allows to drop low priority outputs (periodic temperatures, echo) while the serial output buffer is almost full, see M3410.
+"ok" and "Resend" are never dropped, they wait for free space within the serial output buffer as usual. */
+#define FEATURE_SERIAL_NON_BLOCKING         0                                                   // 1 = on, 0 = off
+
+#if FEATURE_SERIAL_NON_BLOCKING
+/** \brief Number of free bytes within the serial output buffer which are required in order to start a low priority output */
+#define SERIAL_LOW_PRIORITY_RESERVE         48
+
+/** \brief Specifies whether low priority outputs are dropped by default, can be changed via M3410 */
+#define SERIAL_NON_BLOCKING_DEFAULT         1                                                   // 1 = drop, 0 = wait
+#endif // FEATURE_SERIAL_NON_BLOCKING
+
 /** \brief Some boards like Gen7 have a power on pin, to enable the atx power supply. If this is defined,
 the power will be turned on without the need to call M80 if initially started. */
 #define ENABLE_POWER_ON_STARTUP
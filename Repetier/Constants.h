@@ -130,6 +130,39 @@
 #define STOP_BECAUSE_OF_Z_MIN               1
 #define STOP_BECAUSE_OF_Z_BLOCK             2
 
+#define TOOLCHANGE_SCAN_LINE_START          0   // the scan is at the start of a command
+#define TOOLCHANGE_SCAN_TOOL                1   // the scan reads the number of a T command
+#define TOOLCHANGE_SCAN_SKIP_LINE           2   // the scan skips the rest of an ASCII command
+#define TOOLCHANGE_SCAN_BINARY              3   // the scan reads a binary command
+
+#define TEMPERATURE_REPORT_FIXED            0   // the temperature line is sent once per second
+#define TEMPERATURE_REPORT_ADAPTIVE         1   // the temperature line is sent only in case the values have changed noticeably
+#define TEMPERATURE_REPORT_BINARY           2   // like TEMPERATURE_REPORT_ADAPTIVE, but a binary temperature frame is sent instead of the temperature line
+
+#define TEMPERATURE_FRAME_START             0x02    // first byte of a binary temperature frame
+#define TEMPERATURE_FRAME_TYPE              'T'     // second byte of a binary temperature frame
+
+#define SD_BLOCK_FRAME_START                0x02    // first byte of a data block of the block upload (M3416)
+#define SD_BLOCK_FRAME_HEADER_SIZE          5       // start byte, sequence number and payload length
+#define SD_BLOCK_FRAME_CRC_SIZE             2       // CRC-16 behind the payload
+
+#define SD_MOUNT_IDLE                       0   // no mount is in progress
+#define SD_MOUNT_START                      1   // the dummy initialization of the card is started
+#define SD_MOUNT_DUMMY_INIT                 2   // the dummy initialization of the card is in progress
+#define SD_MOUNT_WAIT                       3   // the mount waits for the end of the dummy initialization
+#define SD_MOUNT_CARD_INIT                  4   // the initialization of the card is in progress
+#define SD_MOUNT_VOLUME                     5   // the FAT volume is read
+#define SD_MOUNT_ROOT                       6   // the root folder is opened and init.g is started
+
+#define SD_PREFLIGHT_IDLE                   0   // no file has been scanned
+#define SD_PREFLIGHT_RUNNING                1   // the selected file is scanned
+#define SD_PREFLIGHT_DONE                   2   // the scan of the selected file has been completed
+#define SD_PREFLIGHT_READ_ERROR             3   // the selected file could not be read completely
+
+#define SD_BACKGROUND_LINE_FREE             0   // SDCard::backgroundLine does not hold a partial line
+#define SD_BACKGROUND_LINE_CONVERT          1   // the binary cache conversion collects a line
+#define SD_BACKGROUND_LINE_PREFLIGHT        2   // the pre-flight scan collects a line
+
 
 // ##########################################################################################
 // ##    data types
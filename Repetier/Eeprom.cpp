@@ -115,6 +115,12 @@ void EEPROM::restoreEEPROMSettingsFromConfiguration()
     heatedBedController.pidDGain = HEATED_BED_PID_DGAIN;
     heatedBedController.pidMax = HEATED_BED_PID_MAX;
     heatedBedController.sensorType = HEATED_BED_SENSOR_TYPE;
+
+#if FEATURE_HEAT_MODEL_CONTROL
+    heatedBedController.modelHeatRate = HEATER_MODEL_BED_HEAT_RATE;
+    heatedBedController.modelLossRate = HEATER_MODEL_BED_LOSS_RATE;
+    heatedBedController.modelDeadTime = HEATER_MODEL_BED_DEAD_TIME;
+#endif // FEATURE_HEAT_MODEL_CONTROL
 #endif // HAVE_HEATED_BED
 
 #if FEATURE_MILLING_MODE
@@ -158,6 +164,12 @@ void EEPROM::restoreEEPROMSettingsFromConfiguration()
     e->tempControl.pidIGain = EXT0_PID_I;
     e->tempControl.pidDGain = EXT0_PID_D;
     e->tempControl.pidMax = EXT0_PID_MAX;
+
+#if FEATURE_HEAT_MODEL_CONTROL
+    e->tempControl.modelHeatRate = HEATER_MODEL_EXTRUDER_HEAT_RATE;
+    e->tempControl.modelLossRate = HEATER_MODEL_EXTRUDER_LOSS_RATE;
+    e->tempControl.modelDeadTime = HEATER_MODEL_EXTRUDER_DEAD_TIME;
+#endif // FEATURE_HEAT_MODEL_CONTROL
     e->tempControl.sensorType = EXT0_TEMPSENSOR_TYPE;
 
     e->zOffset = EXT0_Z_OFFSET;
@@ -194,6 +206,12 @@ void EEPROM::restoreEEPROMSettingsFromConfiguration()
     e->tempControl.pidIGain = EXT1_PID_I;
     e->tempControl.pidDGain = EXT1_PID_D;
     e->tempControl.pidMax = EXT1_PID_MAX;
+
+#if FEATURE_HEAT_MODEL_CONTROL
+    e->tempControl.modelHeatRate = HEATER_MODEL_EXTRUDER_HEAT_RATE;
+    e->tempControl.modelLossRate = HEATER_MODEL_EXTRUDER_LOSS_RATE;
+    e->tempControl.modelDeadTime = HEATER_MODEL_EXTRUDER_DEAD_TIME;
+#endif // FEATURE_HEAT_MODEL_CONTROL
     e->tempControl.sensorType = EXT1_TEMPSENSOR_TYPE;
 
     e->zOffset = EXT1_Z_OFFSET;
@@ -231,6 +249,12 @@ void EEPROM::restoreEEPROMSettingsFromConfiguration()
     e->tempControl.pidIGain = EXT2_PID_I;
     e->tempControl.pidDGain = EXT2_PID_D;
     e->tempControl.pidMax = EXT2_PID_MAX;
+
+#if FEATURE_HEAT_MODEL_CONTROL
+    e->tempControl.modelHeatRate = HEATER_MODEL_EXTRUDER_HEAT_RATE;
+    e->tempControl.modelLossRate = HEATER_MODEL_EXTRUDER_LOSS_RATE;
+    e->tempControl.modelDeadTime = HEATER_MODEL_EXTRUDER_DEAD_TIME;
+#endif // FEATURE_HEAT_MODEL_CONTROL
     e->tempControl.sensorType = EXT2_TEMPSENSOR_TYPE;
 
     e->zOffset = EXT2_Z_OFFSET;
@@ -267,6 +291,12 @@ void EEPROM::restoreEEPROMSettingsFromConfiguration()
     e->tempControl.pidIGain = EXT3_PID_I;
     e->tempControl.pidDGain = EXT3_PID_D;
     e->tempControl.pidMax = EXT3_PID_MAX;
+
+#if FEATURE_HEAT_MODEL_CONTROL
+    e->tempControl.modelHeatRate = HEATER_MODEL_EXTRUDER_HEAT_RATE;
+    e->tempControl.modelLossRate = HEATER_MODEL_EXTRUDER_LOSS_RATE;
+    e->tempControl.modelDeadTime = HEATER_MODEL_EXTRUDER_DEAD_TIME;
+#endif // FEATURE_HEAT_MODEL_CONTROL
     e->tempControl.sensorType = EXT3_TEMPSENSOR_TYPE;
 
     e->zOffset = EXT3_Z_OFFSET;
@@ -303,6 +333,12 @@ void EEPROM::restoreEEPROMSettingsFromConfiguration()
     e->tempControl.pidIGain = EXT4_PID_I;
     e->tempControl.pidDGain = EXT4_PID_D;
     e->tempControl.pidMax = EXT4_PID_MAX;
+
+#if FEATURE_HEAT_MODEL_CONTROL
+    e->tempControl.modelHeatRate = HEATER_MODEL_EXTRUDER_HEAT_RATE;
+    e->tempControl.modelLossRate = HEATER_MODEL_EXTRUDER_LOSS_RATE;
+    e->tempControl.modelDeadTime = HEATER_MODEL_EXTRUDER_DEAD_TIME;
+#endif // FEATURE_HEAT_MODEL_CONTROL
     e->tempControl.sensorType = EXT3_TEMPSENSOR_TYPE;
 
     e->zOffset = EXT4_Z_OFFSET;
@@ -339,6 +375,12 @@ void EEPROM::restoreEEPROMSettingsFromConfiguration()
     e->tempControl.pidIGain = EXT5_PID_I;
     e->tempControl.pidDGain = EXT5_PID_D;
     e->tempControl.pidMax = EXT5_PID_MAX;
+
+#if FEATURE_HEAT_MODEL_CONTROL
+    e->tempControl.modelHeatRate = HEATER_MODEL_EXTRUDER_HEAT_RATE;
+    e->tempControl.modelLossRate = HEATER_MODEL_EXTRUDER_LOSS_RATE;
+    e->tempControl.modelDeadTime = HEATER_MODEL_EXTRUDER_DEAD_TIME;
+#endif // FEATURE_HEAT_MODEL_CONTROL
     e->tempControl.sensorType = EXT5_TEMPSENSOR_TYPE;
 
     e->zOffset = EXT5_Z_OFFSET;
@@ -532,6 +574,12 @@ void EEPROM::storeDataIntoEEPROM(uint8_t corrupted)
     HAL::eprSetFloat(EPR_BED_PID_DGAIN,heatedBedController.pidDGain);
     HAL::eprSetByte(EPR_BED_PID_MAX,heatedBedController.pidMax);
     HAL::eprSetByte(EPR_RF_HEATED_BED_SENSOR_TYPE,heatedBedController.sensorType);
+
+#if FEATURE_HEAT_MODEL_CONTROL
+    HAL::eprSetFloat(EPR_BED_MODEL_HEAT_RATE,heatedBedController.modelHeatRate);
+    HAL::eprSetFloat(EPR_BED_MODEL_LOSS_RATE,heatedBedController.modelLossRate);
+    HAL::eprSetFloat(EPR_BED_MODEL_DEAD_TIME,heatedBedController.modelDeadTime);
+#endif // FEATURE_HEAT_MODEL_CONTROL
 #else
     HAL::eprSetByte(EPR_BED_DRIVE_MAX,HEATED_BED_PID_INTEGRAL_DRIVE_MAX);
     HAL::eprSetByte(EPR_BED_DRIVE_MIN,HEATED_BED_PID_INTEGRAL_DRIVE_MIN);
@@ -578,6 +626,12 @@ void EEPROM::storeDataIntoEEPROM(uint8_t corrupted)
         HAL::eprSetByte(o+EPR_EXTRUDER_PID_MAX,e->tempControl.pidMax);
         HAL::eprSetByte(o+EPR_EXTRUDER_SENSOR_TYPE,e->tempControl.sensorType);
 
+#if FEATURE_HEAT_MODEL_CONTROL
+        HAL::eprSetFloat(o+EPR_EXTRUDER_MODEL_HEAT_RATE,e->tempControl.modelHeatRate);
+        HAL::eprSetFloat(o+EPR_EXTRUDER_MODEL_LOSS_RATE,e->tempControl.modelLossRate);
+        HAL::eprSetFloat(o+EPR_EXTRUDER_MODEL_DEAD_TIME,e->tempControl.modelDeadTime);
+#endif // FEATURE_HEAT_MODEL_CONTROL
+
         HAL::eprSetFloat(o+EPR_EXTRUDER_X_OFFSET,e->xOffset/XAXIS_STEPS_PER_MM);
         HAL::eprSetFloat(o+EPR_EXTRUDER_Y_OFFSET,e->yOffset/YAXIS_STEPS_PER_MM);
         HAL::eprSetFloat(o+EPR_EXTRUDER_Z_OFFSET,e->zOffset/ZAXIS_STEPS_PER_MM);   //e->zOffset  Nibbels
@@ -792,6 +846,15 @@ void EEPROM::readDataFromEEPROM()
     heatedBedController.pidDGain = HAL::eprGetFloat(EPR_BED_PID_DGAIN);
     heatedBedController.pidMax = HAL::eprGetByte(EPR_BED_PID_MAX);
     heatedBedController.sensorType = (HAL::eprGetByte(EPR_RF_HEATED_BED_SENSOR_TYPE) != 0) ? HAL::eprGetByte(EPR_RF_HEATED_BED_SENSOR_TYPE) : HEATED_BED_SENSOR_TYPE;
+
+#if FEATURE_HEAT_MODEL_CONTROL
+    if(version>8)
+    {
+        heatedBedController.modelHeatRate = HAL::eprGetFloat(EPR_BED_MODEL_HEAT_RATE);
+        heatedBedController.modelLossRate = HAL::eprGetFloat(EPR_BED_MODEL_LOSS_RATE);
+        heatedBedController.modelDeadTime = HAL::eprGetFloat(EPR_BED_MODEL_DEAD_TIME);
+    }
+#endif // FEATURE_HEAT_MODEL_CONTROL
 #endif // HAVE_HEATED_BED
 
     Printer::minMM[X_AXIS] = HAL::eprGetFloat(EPR_X_HOME_OFFSET);
@@ -855,6 +918,15 @@ void EEPROM::readDataFromEEPROM()
 
         if(version>1)
             e->coolerSpeed = HAL::eprGetByte(o+EPR_EXTRUDER_COOLER_SPEED);
+
+#if FEATURE_HEAT_MODEL_CONTROL
+        if(version>8)
+        {
+            e->tempControl.modelHeatRate = HAL::eprGetFloat(o+EPR_EXTRUDER_MODEL_HEAT_RATE);
+            e->tempControl.modelLossRate = HAL::eprGetFloat(o+EPR_EXTRUDER_MODEL_LOSS_RATE);
+            e->tempControl.modelDeadTime = HAL::eprGetFloat(o+EPR_EXTRUDER_MODEL_DEAD_TIME);
+        }
+#endif // FEATURE_HEAT_MODEL_CONTROL
     }
 
 #if FEATURE_BEEPER
@@ -1295,6 +1367,12 @@ void EEPROM::writeSettings()
     writeFloat(EPR_BED_PID_DGAIN,Com::tEPRBedDGain);
     writeByte(EPR_BED_PID_MAX,Com::tEPRBedPISMaxValue); 
     writeByte(EPR_RF_HEATED_BED_SENSOR_TYPE,Com::tEPRBedsensorType); 
+
+#if FEATURE_HEAT_MODEL_CONTROL
+    writeFloat(EPR_BED_MODEL_HEAT_RATE,Com::tEPRBedModelHeatRate,4);
+    writeFloat(EPR_BED_MODEL_LOSS_RATE,Com::tEPRBedModelLossRate,5);
+    writeFloat(EPR_BED_MODEL_DEAD_TIME,Com::tEPRBedModelDeadTime,1);
+#endif // FEATURE_HEAT_MODEL_CONTROL
 #endif // HAVE_HEATED_BED
 
     // now the extruder
@@ -1315,6 +1393,12 @@ void EEPROM::writeSettings()
         writeByte(o+EPR_EXTRUDER_PID_MAX,Com::tEPRPIDMaxValue);
         writeByte(o+EPR_EXTRUDER_SENSOR_TYPE,Com::tEPRsensorType);
 
+#if FEATURE_HEAT_MODEL_CONTROL
+        writeFloat(o+EPR_EXTRUDER_MODEL_HEAT_RATE,Com::tEPRModelHeatRate,4);
+        writeFloat(o+EPR_EXTRUDER_MODEL_LOSS_RATE,Com::tEPRModelLossRate,5);
+        writeFloat(o+EPR_EXTRUDER_MODEL_DEAD_TIME,Com::tEPRModelDeadTime,1);
+#endif // FEATURE_HEAT_MODEL_CONTROL
+
         writeFloat(o+EPR_EXTRUDER_X_OFFSET,Com::tEPRXOffset);
         writeFloat(o+EPR_EXTRUDER_Y_OFFSET,Com::tEPRYOffset);
         writeFloat(o+EPR_EXTRUDER_Z_OFFSET,Com::tEPRZOffsetmm);
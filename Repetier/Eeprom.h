@@ -20,7 +20,7 @@
 #define EEPROM_H
 
 // Id to distinguish version changes
-#define EEPROM_PROTOCOL_VERSION         8
+#define EEPROM_PROTOCOL_VERSION         9
 
 /** Where to start with our datablock in memory. Can be moved if you
 have problems with other modules using the eeprom */
@@ -143,6 +143,10 @@ have problems with other modules using the eeprom */
 #define EPR_RF_ZERO_DIGIT_STATE           1937 //[1byte]
 #define EPR_RF_DIGIT_CMP_STATE            1938 //[1byte]
 
+#define EPR_BED_MODEL_HEAT_RATE           1939 //+1940+1941+1942 [float]
+#define EPR_BED_MODEL_LOSS_RATE           1943 //+1944+1945+1946 [float]
+#define EPR_BED_MODEL_DEAD_TIME           1947 //+1948+1949+1950 [float]
+
 
 //Nibbels: Computechecksum geht bis 2047
 
@@ -175,6 +179,9 @@ have problems with other modules using the eeprom */
 #define EPR_EXTRUDER_WAIT_RETRACT_TEMP  50
 #define EPR_EXTRUDER_WAIT_RETRACT_UNITS 52
 #define EPR_EXTRUDER_COOLER_SPEED       54 //byte
+#define EPR_EXTRUDER_MODEL_HEAT_RATE    56 //float
+#define EPR_EXTRUDER_MODEL_LOSS_RATE    60 //float
+#define EPR_EXTRUDER_MODEL_DEAD_TIME    64 //float
 #define EPR_EXTRUDER_SENSOR_TYPE        94 //uint8 
 #define EPR_EXTRUDER_Z_OFFSET           95 //int32_t -> +96+97+98
 
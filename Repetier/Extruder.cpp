@@ -39,17 +39,15 @@ volatile uint8      osAnalogInputCounter[ANALOG_INPUTS];
 volatile uint       osAnalogInputBuildup[ANALOG_INPUTS];
 volatile uint8      osAnalogInputPos=0; // Current sampling position
 volatile uint       osAnalogInputValues[ANALOG_INPUTS];
-#endif // ANALOG_INPUTS>0
 
-#ifdef USE_GENERIC_THERMISTORTABLE_1
-short               temptable_generic1[GENERIC_THERM_NUM_ENTRIES][2];
-#endif
-#ifdef USE_GENERIC_THERMISTORTABLE_2
-short               temptable_generic2[GENERIC_THERM_NUM_ENTRIES][2];
-#endif
-#ifdef USE_GENERIC_THERMISTORTABLE_3
-short               temptable_generic3[GENERIC_THERM_NUM_ENTRIES][2];
-#endif
+#if FEATURE_ADC_INTERRUPT
+uint8               osAnalogInputSchedule[ANALOG_INPUT_SLOTS];  // Analog inputs in the order in which they are sampled
+uint8               osAnalogInputSlots = 0;                     // Number of used entries within osAnalogInputSchedule
+volatile uint8      osAnalogInputSlot = 0;                      // Current position within osAnalogInputSchedule
+volatile uint       osAnalogInputFiltered[ANALOG_INPUTS];       // Filtered values, scaled by 2^ANALOG_INPUT_FILTER_SHIFT
+volatile uint32_t   osAnalogInputUpdates[ANALOG_INPUTS];        // Number of decimated values since the last reset of the statistics, read it within an InterruptProtectedBlock
+#endif // FEATURE_ADC_INTERRUPT
+#endif // ANALOG_INPUTS>0
 
 /** Makes updates to temperatures and heater state every call.
 Is called every 100ms.
@@ -119,6 +117,11 @@ void Extruder::manageTemperatures()
         //act->tempPointer &= 3; // 3 = springe von 4 = 100b auf 0 zurück,    wenn 3. -> 1/300ms  -> 3.33 = reciproke     !!tempArray needs [4] ...
         //act->tempPointer &= 7; // 7 = springe von 8 = 1000b auf 0 zurück,   wenn 7. -> 1/700ms  -> 1.42 = reciproke     !!tempArray needs [8] ...
         act->tempPointer &= 15; // 15 = springe von 16 = 10000b zurück auf 0, wenn 15 -> 1/1500ms -> 0.666 = reciproke    !!tempArray needs [16] ...
+
+#if FEATURE_HEATUP_ETA
+        act->updateHeatUpEta();
+#endif // FEATURE_HEATUP_ETA
+
         if(act->heatManager == 1)
         {
             uint8_t output;
@@ -196,6 +199,47 @@ void Extruder::manageTemperatures()
             }
             pwm_pos[act->pwmIndex] = output;
         }
+#if FEATURE_HEAT_MODEL_CONTROL
+        else if(act->heatManager == 4)     // model based control
+        {
+            uint8_t output;
+            int16_t current   = (int16_t)(act->currentTemperatureC * 16.0f);
+            int16_t target    = (int16_t)(act->targetTemperatureC * 16.0f);
+            int16_t raising   = current - (int16_t)(act->tempArray[act->tempPointer] * 16.0f);   // temperature change within the last 1.5 s
+            int16_t predicted = current + (int16_t)(((int32_t)raising * act->modelPrediction) >> 8);
+            int16_t error     = target - predicted;                                               // error at the time the heater output of now reaches the sensor
+
+            if( act->targetTemperatureC < 20.0f || !act->modelPGain )
+            {
+                output = 0; // off is off
+                act->modelIState = 0;
+            }
+            else if( error > PID_CONTROL_RANGE * 16 )
+            {
+                output = act->pidMax;
+                act->modelIState = 0;
+            }
+            else if( error < -PID_CONTROL_RANGE * 16 )
+            {
+                output = 0;
+            }
+            else
+            {
+                // feed-forward: the output which holds the target temperature according to the model, the fixed point PI control corrects the residual
+                int32_t term = ((int32_t)(target - HEATER_MODEL_AMBIENT_TEMPERATURE * 16) * act->modelFeedForward) >> 12;
+                term += ((int32_t)error * act->modelPGain) >> 12;
+                term += (act->modelIState * act->modelIGain) >> 20;
+
+                if( (term < act->pidMax || error < 0) && (term > 0 || error > 0) )
+                {
+                    // integrate only while the output is not saturated
+                    act->modelIState = constrain(act->modelIState + error, -act->modelIStateLimit, act->modelIStateLimit);
+                }
+                output = constrain(term, 0, (int32_t)act->pidMax);
+            }
+            pwm_pos[act->pwmIndex] = output;
+        }
+#endif // FEATURE_HEAT_MODEL_CONTROL
         else
 
             if(act->heatManager == 2)    // Bang-bang with reduced change frequency to save relais life
@@ -226,6 +270,10 @@ void Extruder::manageTemperatures()
     if(errorDetected == 0 && extruderTempErrors>0)
         extruderTempErrors--;
 
+#if FEATURE_HEATER_POWER_BUDGET
+    applyPowerBudget();
+#endif // FEATURE_HEATER_POWER_BUDGET
+
     if(Printer::isAnyTempsensorDefect())
     {
         for(uint8_t i=0; i<NUM_TEMPERATURE_LOOPS; i++)
@@ -238,49 +286,120 @@ void Extruder::manageTemperatures()
 } // manageTemperatures
 
 
-void Extruder::initHeatedBed()
+#if FEATURE_HEATER_POWER_BUDGET
+/** \brief Limits the outputs of the heaters to the power budget of the power supply.
+The heaters which hold their temperature get their power first, so that their control is not disturbed. The remaining power is allocated to the heating heaters
+in the order of their priority and of their remaining error. Heaters which are tuned at the moment and heaters with reduced change frequency (heat manager 2) are not limited. */
+void Extruder::applyPowerBudget()
 {
-#if HAVE_HEATED_BED
-    heatedBedController.updateTempControlVars();
-#endif // HAVE_HEATED_BED
+    int32_t     budget = (int32_t)HEATER_POWER_BUDGET * 255;   // [W/255]
+    int32_t     requested = 0;
+    uint32_t    request[NUM_TEMPERATURE_LOOPS];                 // [W/255]
+    uint8_t     order[NUM_TEMPERATURE_LOOPS];
+    uint8_t     key[NUM_TEMPERATURE_LOOPS];
+    float       error[NUM_TEMPERATURE_LOOPS];
+    uint8_t     count = 0;
+    uint8_t     i, j;
+
+
+#if FEATURE_24V_FET_OUTPUTS
+    if( Printer::enableFET1 )   budget -= FET_OUTPUT_POWER * 255;
+    if( Printer::enableFET2 )   budget -= FET_OUTPUT_POWER * 255;
+    if( Printer::enableFET3 )   budget -= FET_OUTPUT_POWER * 255;
+#endif // FEATURE_24V_FET_OUTPUTS
+
+    for( i = 0; i < NUM_TEMPERATURE_LOOPS; i++ )
+    {
+        TemperatureController*  act   = tempController[i];
+        uint16_t                power = (i < NUM_EXTRUDER ? EXTRUDER_HEATER_POWER : HEATED_BED_HEATER_POWER);
 
-} // initHeatedBed
 
+        request[i] = (uint32_t)pwm_pos[act->pwmIndex] * power;
+        if( i == autotuneIndex || act->heatManager == 2 )
+        {
+            // this output is not limited, but it uses a part of the budget
+            budget -= request[i];
+            continue;
+        }
+        if( !request[i] ) continue;
 
-#if defined(USE_GENERIC_THERMISTORTABLE_1) || defined(USE_GENERIC_THERMISTORTABLE_2) || defined(USE_GENERIC_THERMISTORTABLE_3)
-void createGenericTable(short table[GENERIC_THERM_NUM_ENTRIES][2],short minTemp,short maxTemp,float beta,float r0,float t0,float r1,float r2)
-{
-    t0 += 273.15f;
-    float rs, vs;
-    if(r1==0)
+        requested += request[i];
+        error[i]   = act->targetTemperatureC - act->currentTemperatureC;
+        key[i]     = (fabs(error[i]) <= PID_CONTROL_RANGE ? 0 : 1 + (i < NUM_EXTRUDER ? EXTRUDER_HEATER_PRIORITY : HEATED_BED_HEATER_PRIORITY));
+
+        // sort by holding/priority first and by the remaining error second
+        for( j = count; j > 0; j-- )
+        {
+            uint8_t other = order[j-1];
+            if( key[other] < key[i] || (key[other] == key[i] && error[other] >= error[i]) ) break;
+            order[j] = other;
+        }
+        order[j] = i;
+        count ++;
+    }
+
+    if( requested <= budget ) return;
+
+    for( j = 0; j < count; j++ )
     {
-        rs = r2;
-        vs = GENERIC_THERM_VREF;
+        TemperatureController*  act;
+        uint8_t                 output;
+
+
+        i = order[j];
+        if( (int32_t)request[i] > budget )
+        {
+            act    = tempController[i];
+            output = (budget <= 0 ? 0 : budget / (i < NUM_EXTRUDER ? EXTRUDER_HEATER_POWER : HEATED_BED_HEATER_POWER));
+
+            // the control must not integrate the power which the heater does not get
+            act->limitIntegralState( pwm_pos[act->pwmIndex] - output );
+            pwm_pos[act->pwmIndex] = output;
+        }
+        budget -= request[i];
     }
-    else
+
+} // applyPowerBudget
+
+
+/** \brief Removes the part of the output which the power budget has cut off from the integral state of the control (back-calculation), so that the integral does not wind up while
+the heater gets less power than the control requests. The integral state is reduced down to 0 at most. */
+void TemperatureController::limitIntegralState(uint8_t excess)
+{
+    if( heatManager == 1 && pidIGain > 0 && tempIState > 0 )
     {
-        vs =static_cast<float>((GENERIC_THERM_VREF * r1) / (r1 + r2));
-        rs = (r2 * r1) / (r1 + r2);
+        float   term = excess;
+
+
+#if SCALE_PID_TO_MAX==1
+        term = term * 256.0f / pidMax;
+#endif // SCALE_PID_TO_MAX==1
+
+        // see manageTemperatures(): the integral term is pidIGain * tempIState * 0.1
+        tempIState = RMath::max(tempIState - term * 10.0f / pidIGain, 0.0f);
     }
-    float k = r0 * exp(-beta / t0);
-    float delta = (maxTemp-minTemp) / (GENERIC_THERM_NUM_ENTRIES - 1.0f);
-    for(uint8_t i = 0; i < GENERIC_THERM_NUM_ENTRIES; i++)
+#if FEATURE_HEAT_MODEL_CONTROL
+    else if( heatManager == 4 && modelIGain && modelIState > 0 )
     {
-        float t = maxTemp - i * delta;
-        float r = exp(beta / (t + 272.65)) * k;
-        float v = 4092 * r * vs / ((rs + r) * GENERIC_THERM_VREF);
-        int adc = static_cast<int>(v);
-        t *= 8;
-        if(adc > 4092) adc = 4092;
-        table[i][0] = (adc >> (ANALOG_REDUCE_BITS));
-        table[i][1] = static_cast<int>(t);
-#ifdef DEBUG_GENERIC
-        Com::printF(Com::tGenTemp,table[i][0]);
-        Com::printFLN(Com::tComma,table[i][1]);
-#endif
+        // see manageTemperatures(): the integral term is (modelIState * modelIGain) >> 20
+        int32_t state = (int32_t)((((uint32_t)excess << 20) + modelIGain - 1) / modelIGain);
+
+
+        modelIState = (modelIState > state ? modelIState - state : 0);
     }
-}
-#endif
+#endif // FEATURE_HEAT_MODEL_CONTROL
+
+} // limitIntegralState
+#endif // FEATURE_HEATER_POWER_BUDGET
+
+
+void Extruder::initHeatedBed()
+{
+#if HAVE_HEATED_BED
+    heatedBedController.updateTempControlVars();
+#endif // HAVE_HEATED_BED
+
+} // initHeatedBed
 
 
 /** \brief Initalizes all extruder.
@@ -293,18 +412,6 @@ void Extruder::initExtruder()
     uint8_t i;
     Extruder::current = &extruder[0];
 
-#ifdef USE_GENERIC_THERMISTORTABLE_1
-    createGenericTable(temptable_generic1,GENERIC_THERM1_MIN_TEMP,GENERIC_THERM1_MAX_TEMP,GENERIC_THERM1_BETA,GENERIC_THERM1_R0,GENERIC_THERM1_T0,GENERIC_THERM1_R1,GENERIC_THERM1_R2);
-#endif // USE_GENERIC_THERMISTORTABLE_1
-
-#ifdef USE_GENERIC_THERMISTORTABLE_2
-    createGenericTable(temptable_generic2,GENERIC_THERM2_MIN_TEMP,GENERIC_THERM2_MAX_TEMP,GENERIC_THERM2_BETA,GENERIC_THERM2_R0,GENERIC_THERM2_T0,GENERIC_THERM2_R1,GENERIC_THERM2_R2);
-#endif // USE_GENERIC_THERMISTORTABLE_2
-
-#ifdef USE_GENERIC_THERMISTORTABLE_3
-    createGenericTable(temptable_generic3,GENERIC_THERM3_MIN_TEMP,GENERIC_THERM3_MAX_TEMP,GENERIC_THERM3_BETA,GENERIC_THERM3_R0,GENERIC_THERM3_T0,GENERIC_THERM3_R1,GENERIC_THERM3_R2);
-#endif // USE_GENERIC_THERMISTORTABLE_3
-
 #if defined(EXT0_STEP_PIN) && EXT0_STEP_PIN>-1
     SET_OUTPUT(EXT0_DIR_PIN);
     SET_OUTPUT(EXT0_STEP_PIN);
@@ -373,6 +480,28 @@ void TemperatureController::updateTempControlVars()
 */
     }
 
+#if FEATURE_HEAT_MODEL_CONTROL
+    if(modelHeatRate>0 && modelLossRate>=0)
+    {
+        // the residual control is tuned from the model: P = tau / (K * 2 * dead time), integral time = min(tau, 8 * dead time)
+        float deadTime = RMath::max(modelDeadTime,0.5f);
+        float pGain    = 255.0f / (modelHeatRate * 2.0f * deadTime);
+        float iGain    = pGain * 0.1f * RMath::max(modelLossRate,0.125f / deadTime);  // 0.1 = 10Hz
+
+        modelFeedForward = (uint16_t)RMath::min(255.0f * modelLossRate / modelHeatRate * 256.0f,65535.0f);
+        modelPGain       = (uint16_t)RMath::min(pGain * 256.0f,65535.0f);
+        modelIGain       = (uint16_t)RMath::max(RMath::min(iGain * 65536.0f,65535.0f),1.0f);
+        modelPrediction  = (uint16_t)RMath::min(deadTime * 0.666f * 256.0f,65535.0f);
+        modelIStateLimit = ((int32_t)pidDriveMax << 20) / modelIGain;
+    }
+    else
+    {
+        modelFeedForward = modelPGain = modelIGain = modelPrediction = 0;
+        modelIStateLimit = 0;
+    }
+    modelIState = constrain(modelIState,-modelIStateLimit,modelIStateLimit);
+#endif // FEATURE_HEAT_MODEL_CONTROL
+
 } // updateTempControlVars
 
 
@@ -651,7 +780,7 @@ void Extruder::disableAllExtruders()
 
 #define NUMTEMPS_1 28
 // Epcos B57560G0107F000
-const short temptable_1[NUMTEMPS_1][2] PROGMEM =
+constexpr short temptable_1[NUMTEMPS_1][2] PROGMEM =
 {
     {0,4000},{92,2400},{105,2320},{121,2240},{140,2160},{162,2080},{189,2000},{222,1920},{261,1840},{308,1760},
     {365,1680},{434,1600},{519,1520},{621,1440},{744,1360},{891,1280},{1067,1200},{1272,1120},
@@ -660,7 +789,7 @@ const short temptable_1[NUMTEMPS_1][2] PROGMEM =
 
 // is 200k thermistor
 #define NUMTEMPS_2 21
-const short temptable_2[NUMTEMPS_2][2] PROGMEM =
+constexpr short temptable_2[NUMTEMPS_2][2] PROGMEM =
 {
     {1*4, 848*8},{54*4, 275*8}, {107*4, 228*8}, {160*4, 202*8},{213*4, 185*8}, {266*4, 171*8}, {319*4, 160*8}, {372*4, 150*8},
     {425*4, 141*8}, {478*4, 133*8},{531*4, 125*8},{584*4, 118*8},{637*4, 110*8},{690*4, 103*8},{743*4, 95*8},{796*4, 86*8},
@@ -670,7 +799,7 @@ const short temptable_2[NUMTEMPS_2][2] PROGMEM =
 // mendel-parts thermistor (EPCOS G550) = NTC mit 100kOhm
 #define NUMTEMPS_3 28 
 
-const short temptable_3[NUMTEMPS_3][2] PROGMEM =
+constexpr short temptable_3[NUMTEMPS_3][2] PROGMEM =
 {
     {1*4,864*8},{21*4,300*8},{25*4,290*8},{29*4,280*8},{33*4,270*8},{39*4,260*8},{46*4,250*8},{54*4,240*8},{64*4,230*8},{75*4,220*8},
     {90*4,210*8},{107*4,200*8},{128*4,190*8},{154*4,180*8},{184*4,170*8},{221*4,160*8},{265*4,150*8},{316*4,140*8},{375*4,130*8},
@@ -679,7 +808,7 @@ const short temptable_3[NUMTEMPS_3][2] PROGMEM =
 
 // is 10k thermistor
 #define NUMTEMPS_4 20
-const short temptable_4[NUMTEMPS_4][2] PROGMEM =
+constexpr short temptable_4[NUMTEMPS_4][2] PROGMEM =
 {
     {1*4, 430*8},{54*4, 137*8},{107*4, 107*8},{160*4, 91*8},{213*4, 80*8},{266*4, 71*8},{319*4, 64*8},{372*4, 57*8},{425*4, 51*8},
     {478*4, 46*8},{531*4, 41*8},{584*4, 35*8},{637*4, 30*8},{690*4, 25*8},{743*4, 20*8},{796*4, 14*8},{849*4, 7*8},{902*4, 0*8},
@@ -688,7 +817,7 @@ const short temptable_4[NUMTEMPS_4][2] PROGMEM =
 
 // ATC Semitec 104GT-2 / E3D Hotend Thermistor
 #define NUMTEMPS_8 34 
-const short temptable_8[NUMTEMPS_8][2] PROGMEM =
+constexpr short temptable_8[NUMTEMPS_8][2] PROGMEM =
 {
     {0,8000},{69,2400},{79,2320},{92,2240},{107,2160},{125,2080},{146,2000},{172,1920},{204,1840},{222,1760},{291,1680},{350,1600},
     {422,1520},{511,1440},{621,1360},{755,1280},{918,1200},{1114,1120},{1344,1040},{1608,960},{1902,880},{2216,800},{2539,720},
@@ -696,8 +825,8 @@ const short temptable_8[NUMTEMPS_8][2] PROGMEM =
 };
 
 // 100k Honeywell 135-104LAG-J01
-#define NUMTEMPS_9 67 
-const short temptable_9[NUMTEMPS_9][2] PROGMEM =
+#define NUMTEMPS_9 58 
+constexpr short temptable_9[NUMTEMPS_9][2] PROGMEM =
 {
     {1*4, 941*8},{19*4, 362*8},{37*4, 299*8}, //top rating 300C
     {55*4, 266*8},{73*4, 245*8},{91*4, 229*8},{109*4, 216*8},{127*4, 206*8},{145*4, 197*8},{163*4, 190*8},{181*4, 183*8},{199*4, 177*8},
@@ -711,7 +840,7 @@ const short temptable_9[NUMTEMPS_9][2] PROGMEM =
 
 // 100k 0603 SMD Vishay NTCS0603E3104FXT (4.7k pullup)
 #define NUMTEMPS_10 20 
-const short temptable_10[NUMTEMPS_10][2] PROGMEM =
+constexpr short temptable_10[NUMTEMPS_10][2] PROGMEM =
 {
     {1*4, 704*8},{54*4, 216*8},{107*4, 175*8},{160*4, 152*8},{213*4, 137*8},{266*4, 125*8},{319*4, 115*8},{372*4, 106*8},{425*4, 99*8},
     {478*4, 91*8},{531*4, 85*8},{584*4, 78*8},{637*4, 71*8},{690*4, 65*8},{743*4, 58*8},{796*4, 50*8},{849*4, 42*8},{902*4, 31*8},
@@ -720,7 +849,7 @@ const short temptable_10[NUMTEMPS_10][2] PROGMEM =
 
 // 100k GE Sensing AL03006-58.2K-97-G1 (4.7k pullup)
 #define NUMTEMPS_11 31 
-const short temptable_11[NUMTEMPS_11][2] PROGMEM =
+constexpr short temptable_11[NUMTEMPS_11][2] PROGMEM =
 {
     {1*4, 936*8},{36*4, 300*8},{71*4, 246*8},{106*4, 218*8},{141*4, 199*8},{176*4, 185*8},{211*4, 173*8},{246*4, 163*8},{281*4, 155*8},
     {316*4, 147*8},{351*4, 140*8},{386*4, 134*8},{421*4, 128*8},{456*4, 122*8},{491*4, 117*8},{526*4, 112*8},{561*4, 107*8},{596*4, 102*8},
@@ -730,7 +859,7 @@ const short temptable_11[NUMTEMPS_11][2] PROGMEM =
 
 // 100k RS thermistor 198-961 (4.7k pullup)
 #define NUMTEMPS_12 31 
-const short temptable_12[NUMTEMPS_12][2] PROGMEM =
+constexpr short temptable_12[NUMTEMPS_12][2] PROGMEM =
 {
     {1*4, 929*8},{36*4, 299*8},{71*4, 246*8},{106*4, 217*8},{141*4, 198*8},{176*4, 184*8},{211*4, 173*8},{246*4, 163*8},{281*4, 154*8},{316*4, 147*8},
     {351*4, 140*8},{386*4, 134*8},{421*4, 128*8},{456*4, 122*8},{491*4, 117*8},{526*4, 112*8},{561*4, 107*8},{596*4, 102*8},{631*4, 97*8},{666*4, 91*8},
@@ -739,7 +868,7 @@ const short temptable_12[NUMTEMPS_12][2] PROGMEM =
 
 // PT100 E3D
 #define NUMTEMPS_13 19 
-const short temptable_13[NUMTEMPS_13][2] PROGMEM =
+constexpr short temptable_13[NUMTEMPS_13][2] PROGMEM =
 {
     {0,0},{908,8},{942,10*8},{982,20*8},{1015,8*30},{1048,8*40},{1080,8*50},{1113,8*60},{1146,8*70},{1178,8*80},{1211,8*90},{1276,8*110},{1318,8*120}
     ,{1670,8*230},{2455,8*500},{3445,8*900},{3666,8*1000},{3871,8*1100},{4095,8*2000}
@@ -747,7 +876,7 @@ const short temptable_13[NUMTEMPS_13][2] PROGMEM =
 
 // Thermistor NTC 3950 100k Ohm (result seems a bit to cold for my amazon-ntcs)
 #define NUMTEMPS_14 46 
-const short temptable_14[NUMTEMPS_14][2] PROGMEM = {
+constexpr short temptable_14[NUMTEMPS_14][2] PROGMEM = {
     {1*4,8*938}, {31*4,8*314}, {41*4,8*290}, {51*4,8*272}, {61*4,8*258}, {71*4,8*247}, {81*4,8*237}, {91*4,8*229}, {101*4,8*221}, {111*4,8*215}, {121*4,8*209},
     {131*4,8*204}, {141*4,8*199}, {151*4,8*195}, {161*4,8*190}, {171*4,8*187}, {181*4,8*183}, {191*4,8*179}, {201*4,8*176}, {221*4,8*170}, {241*4,8*165}, 
     {261*4,8*160}, {281*4,8*155}, {301*4,8*150}, {331*4,8*144}, {361*4,8*139}, {391*4,8*133}, {421*4,8*128}, {451*4,8*123}, {491*4,8*117}, {531*4,8*111}, 
@@ -757,7 +886,7 @@ const short temptable_14[NUMTEMPS_14][2] PROGMEM = {
 
 // Thermistor NTC 3950 100k Ohm (other source)
 #define NUMTEMPS_15 103 
-const short temptable_15[NUMTEMPS_15][2] PROGMEM = {
+constexpr short temptable_15[NUMTEMPS_15][2] PROGMEM = {
     {1*4,938*8},{11*4,423*8},{21*4,351*8},{31*4,314*8},{41*4,290*8},{51*4,272*8},{61*4,258*8},{71*4,247*8},\
 {81*4,237*8},{91*4,229*8},{101*4,221*8},{111*4,215*8},{121*4,209*8},{131*4,204*8},{141*4,199*8},{151*4,195*8},\
 {161*4,190*8},{171*4,187*8},{181*4,183*8},{191*4,179*8},{201*4,176*8},{211*4,173*8},{221*4,170*8},{231*4,167*8},\
@@ -775,15 +904,15 @@ const short temptable_15[NUMTEMPS_15][2] PROGMEM = {
 
 
 #if NUM_TEMPS_USERTHERMISTOR0>0
-const short temptable_5[NUM_TEMPS_USERTHERMISTOR0][2] PROGMEM = USER_THERMISTORTABLE0 ;
+constexpr short temptable_5[NUM_TEMPS_USERTHERMISTOR0][2] PROGMEM = USER_THERMISTORTABLE0 ;
 #endif // NUM_TEMPS_USERTHERMISTOR0>0
 
 #if NUM_TEMPS_USERTHERMISTOR1>0
-const short temptable_6[NUM_TEMPS_USERTHERMISTOR1][2] PROGMEM = USER_THERMISTORTABLE1 ;
+constexpr short temptable_6[NUM_TEMPS_USERTHERMISTOR1][2] PROGMEM = USER_THERMISTORTABLE1 ;
 #endif // NUM_TEMPS_USERTHERMISTOR1>0
 
 #if NUM_TEMPS_USERTHERMISTOR2>0
-const short temptable_7[NUM_TEMPS_USERTHERMISTOR2][2] PROGMEM = USER_THERMISTORTABLE2 ;
+constexpr short temptable_7[NUM_TEMPS_USERTHERMISTOR2][2] PROGMEM = USER_THERMISTORTABLE2 ;
 #endif // NUM_TEMPS_USERTHERMISTOR2>0
 
 const short * const temptables[15] PROGMEM = {(short int *)&temptable_1[0][0],(short int *)&temptable_2[0][0],(short int *)&temptable_3[0][0],(short int *)&temptable_4[0][0]
@@ -819,6 +948,174 @@ const uint8_t temptables_num[15] PROGMEM = {NUMTEMPS_1,NUMTEMPS_2,NUMTEMPS_3,NUM
                                            };
 
 
+/*
+The thermistor tables are not uniformly spaced. In order to avoid walking through the whole table within updateCurrentTemperature(),
+the following index tables are computed at compile time. For every block of 2^TEMPTABLE_INDEX_SHIFT raw values, they store the first
+table entry which may lie above the raw values of the block, so that the search is reduced to a few steps (at most 3, 10 for the dense table of type 9).
+The thermistor tables themselves are kept because their corners can not be represented by a uniformly spaced table without loosing precision.
+*/
+#define TEMPTABLE_INDEX_SHIFT       5
+#define TEMPTABLE_INDEX_ENTRIES     ((4096>>TEMPTABLE_INDEX_SHIFT)+1)
+
+#define TEMPTABLE_ROW_8(entry,t,b)  entry(t,b),entry(t,(b)+1),entry(t,(b)+2),entry(t,(b)+3),entry(t,(b)+4),entry(t,(b)+5),entry(t,(b)+6),entry(t,(b)+7)
+#define TEMPTABLE_ROW_64(entry,t,b) TEMPTABLE_ROW_8(entry,t,b),TEMPTABLE_ROW_8(entry,t,(b)+8),TEMPTABLE_ROW_8(entry,t,(b)+16),TEMPTABLE_ROW_8(entry,t,(b)+24),TEMPTABLE_ROW_8(entry,t,(b)+32),TEMPTABLE_ROW_8(entry,t,(b)+40),TEMPTABLE_ROW_8(entry,t,(b)+48),TEMPTABLE_ROW_8(entry,t,(b)+56)
+#define TEMPTABLE_UNIFORM(entry,t)  { TEMPTABLE_ROW_64(entry,t,0),TEMPTABLE_ROW_64(entry,t,64),entry(t,128) }
+#define TEMPTABLE_INDEX_ENTRY(t,b)  temptableIndex(t,sizeof(t)/sizeof(t[0]),(b)<<TEMPTABLE_INDEX_SHIFT,1)
+
+constexpr uint8_t temptableIndex(const short (*table)[2],uint8_t num,short raw,uint8_t i)
+{
+    // returns the first entry with a raw value above raw or num in case there is no such entry
+    return (i >= num || table[i][0] > raw) ? i : temptableIndex(table,num,raw,i+1);
+
+} // temptableIndex
+
+
+constexpr bool temptableIsSorted(const short (*table)[2],uint8_t num,uint8_t i)
+{
+    // the index and the interpolation need strictly increasing raw values, missing entries of a table which is shorter than its NUMTEMPS are 0 and fail here
+    return i+1 >= num || (table[i][0] < table[i+1][0] && temptableIsSorted(table,num,i+1));
+
+} // temptableIsSorted
+
+
+constexpr bool temptableIsMonotonic(const short (*table)[2],uint8_t num,uint8_t i,bool rising)
+{
+    // the temperatures must change in one direction only
+    return i+1 >= num || ((rising ? table[i][1] <= table[i+1][1] : table[i][1] >= table[i+1][1]) && temptableIsMonotonic(table,num,i+1,rising));
+
+} // temptableIsMonotonic
+
+#define TEMPTABLE_CHECK(t)          static_assert(sizeof(t)/sizeof(t[0]) >= 2 && sizeof(t)/sizeof(t[0]) <= 255, #t " must have 2 to 255 entries"); \
+                                    static_assert(temptableIsSorted(t,sizeof(t)/sizeof(t[0]),0), #t " must have strictly increasing raw values"); \
+                                    static_assert(temptableIsMonotonic(t,sizeof(t)/sizeof(t[0]),0,t[0][1] <= t[sizeof(t)/sizeof(t[0])-1][1]), #t " must have monotonic temperatures")
+
+TEMPTABLE_CHECK(temptable_1);
+TEMPTABLE_CHECK(temptable_2);
+TEMPTABLE_CHECK(temptable_3);
+TEMPTABLE_CHECK(temptable_4);
+#if NUM_TEMPS_USERTHERMISTOR0>0
+TEMPTABLE_CHECK(temptable_5);
+#endif // NUM_TEMPS_USERTHERMISTOR0>0
+#if NUM_TEMPS_USERTHERMISTOR1>0
+TEMPTABLE_CHECK(temptable_6);
+#endif // NUM_TEMPS_USERTHERMISTOR1>0
+#if NUM_TEMPS_USERTHERMISTOR2>0
+TEMPTABLE_CHECK(temptable_7);
+#endif // NUM_TEMPS_USERTHERMISTOR2>0
+TEMPTABLE_CHECK(temptable_8);
+TEMPTABLE_CHECK(temptable_9);
+TEMPTABLE_CHECK(temptable_10);
+TEMPTABLE_CHECK(temptable_11);
+TEMPTABLE_CHECK(temptable_12);
+TEMPTABLE_CHECK(temptable_13);
+TEMPTABLE_CHECK(temptable_14);
+TEMPTABLE_CHECK(temptable_15);
+
+const uint8_t temptable_index_1[TEMPTABLE_INDEX_ENTRIES] PROGMEM = TEMPTABLE_UNIFORM(TEMPTABLE_INDEX_ENTRY,temptable_1);
+const uint8_t temptable_index_2[TEMPTABLE_INDEX_ENTRIES] PROGMEM = TEMPTABLE_UNIFORM(TEMPTABLE_INDEX_ENTRY,temptable_2);
+const uint8_t temptable_index_3[TEMPTABLE_INDEX_ENTRIES] PROGMEM = TEMPTABLE_UNIFORM(TEMPTABLE_INDEX_ENTRY,temptable_3);
+const uint8_t temptable_index_4[TEMPTABLE_INDEX_ENTRIES] PROGMEM = TEMPTABLE_UNIFORM(TEMPTABLE_INDEX_ENTRY,temptable_4);
+#if NUM_TEMPS_USERTHERMISTOR0>0
+const uint8_t temptable_index_5[TEMPTABLE_INDEX_ENTRIES] PROGMEM = TEMPTABLE_UNIFORM(TEMPTABLE_INDEX_ENTRY,temptable_5);
+#endif // NUM_TEMPS_USERTHERMISTOR0>0
+#if NUM_TEMPS_USERTHERMISTOR1>0
+const uint8_t temptable_index_6[TEMPTABLE_INDEX_ENTRIES] PROGMEM = TEMPTABLE_UNIFORM(TEMPTABLE_INDEX_ENTRY,temptable_6);
+#endif // NUM_TEMPS_USERTHERMISTOR1>0
+#if NUM_TEMPS_USERTHERMISTOR2>0
+const uint8_t temptable_index_7[TEMPTABLE_INDEX_ENTRIES] PROGMEM = TEMPTABLE_UNIFORM(TEMPTABLE_INDEX_ENTRY,temptable_7);
+#endif // NUM_TEMPS_USERTHERMISTOR2>0
+const uint8_t temptable_index_8[TEMPTABLE_INDEX_ENTRIES] PROGMEM = TEMPTABLE_UNIFORM(TEMPTABLE_INDEX_ENTRY,temptable_8);
+const uint8_t temptable_index_9[TEMPTABLE_INDEX_ENTRIES] PROGMEM = TEMPTABLE_UNIFORM(TEMPTABLE_INDEX_ENTRY,temptable_9);
+const uint8_t temptable_index_10[TEMPTABLE_INDEX_ENTRIES] PROGMEM = TEMPTABLE_UNIFORM(TEMPTABLE_INDEX_ENTRY,temptable_10);
+const uint8_t temptable_index_11[TEMPTABLE_INDEX_ENTRIES] PROGMEM = TEMPTABLE_UNIFORM(TEMPTABLE_INDEX_ENTRY,temptable_11);
+const uint8_t temptable_index_12[TEMPTABLE_INDEX_ENTRIES] PROGMEM = TEMPTABLE_UNIFORM(TEMPTABLE_INDEX_ENTRY,temptable_12);
+const uint8_t temptable_index_13[TEMPTABLE_INDEX_ENTRIES] PROGMEM = TEMPTABLE_UNIFORM(TEMPTABLE_INDEX_ENTRY,temptable_13);
+const uint8_t temptable_index_14[TEMPTABLE_INDEX_ENTRIES] PROGMEM = TEMPTABLE_UNIFORM(TEMPTABLE_INDEX_ENTRY,temptable_14);
+const uint8_t temptable_index_15[TEMPTABLE_INDEX_ENTRIES] PROGMEM = TEMPTABLE_UNIFORM(TEMPTABLE_INDEX_ENTRY,temptable_15);
+
+const uint8_t * const temptables_index[15] PROGMEM = {temptable_index_1,temptable_index_2,temptable_index_3,temptable_index_4
+#if NUM_TEMPS_USERTHERMISTOR0>0
+        ,temptable_index_5
+#else
+        ,0
+#endif // NUM_TEMPS_USERTHERMISTOR0>0
+
+#if NUM_TEMPS_USERTHERMISTOR1>0
+        ,temptable_index_6
+#else
+        ,0
+#endif // NUM_TEMPS_USERTHERMISTOR1>0
+
+#if NUM_TEMPS_USERTHERMISTOR2>0
+        ,temptable_index_7
+#else
+        ,0
+#endif // NUM_TEMPS_USERTHERMISTOR2>0
+
+        ,temptable_index_8,temptable_index_9,temptable_index_10,temptable_index_11,temptable_index_12,temptable_index_13,temptable_index_14,temptable_index_15
+                                                     };
+
+
+#if defined(USE_GENERIC_THERMISTORTABLE_1) || defined(USE_GENERIC_THERMISTORTABLE_2) || defined(USE_GENERIC_THERMISTORTABLE_3)
+/*
+The generic thermistor tables are computed at compile time from the beta equation. They are uniformly spaced, so that
+the temperature can be interpolated directly from the entry at raw>>TEMPTABLE_INDEX_SHIFT and its successor.
+*/
+constexpr float genericThermistorVs(float r1,float r2)
+{
+    return (r1 == 0 ? GENERIC_THERM_VREF : GENERIC_THERM_VREF * r1 / (r1 + r2));
+
+} // genericThermistorVs
+
+
+constexpr float genericThermistorRs(float r1,float r2)
+{
+    return (r1 == 0 ? r2 : r2 * r1 / (r1 + r2));
+
+} // genericThermistorRs
+
+
+constexpr float genericThermistorCelsius(float raw,float beta,float r0,float t0,float r1,float r2)
+{
+    // the resistance of the thermistor follows from the voltage divider, the temperature from R = R0 * exp(beta/T - beta/T0)
+    return beta / __builtin_log(raw * genericThermistorRs(r1,r2) * GENERIC_THERM_VREF / (4092 * genericThermistorVs(r1,r2) - raw * GENERIC_THERM_VREF)
+                                / (r0 * __builtin_exp(-beta / (t0 + 273.15f)))) - 272.65f;
+
+} // genericThermistorCelsius
+
+
+constexpr short genericThermistorLimit(float celsius,short minTemp,short maxTemp)
+{
+    return (celsius < minTemp ? minTemp * (1<<CELSIUS_EXTRA_BITS) : celsius > maxTemp ? maxTemp * (1<<CELSIUS_EXTRA_BITS) : (short)(celsius * (1<<CELSIUS_EXTRA_BITS)));
+
+} // genericThermistorLimit
+
+
+constexpr short genericThermistorTemperature(short raw,float beta,float r0,float t0,float r1,float r2,short minTemp,short maxTemp)
+{
+    return (raw <= 0 ? maxTemp * (1<<CELSIUS_EXTRA_BITS) :
+            4092 * genericThermistorVs(r1,r2) <= raw * GENERIC_THERM_VREF ? minTemp * (1<<CELSIUS_EXTRA_BITS) :
+            genericThermistorLimit(genericThermistorCelsius(raw,beta,r0,t0,r1,r2),minTemp,maxTemp));
+
+} // genericThermistorTemperature
+
+#define GENERIC_TEMPTABLE_ENTRY(n,b) genericThermistorTemperature((b)<<TEMPTABLE_INDEX_SHIFT,GENERIC_THERM##n##_BETA,GENERIC_THERM##n##_R0,GENERIC_THERM##n##_T0, \
+                                                                  GENERIC_THERM##n##_R1,GENERIC_THERM##n##_R2,GENERIC_THERM##n##_MIN_TEMP,GENERIC_THERM##n##_MAX_TEMP)
+#endif // defined(USE_GENERIC_THERMISTORTABLE_1) || defined(USE_GENERIC_THERMISTORTABLE_2) || defined(USE_GENERIC_THERMISTORTABLE_3)
+
+#ifdef USE_GENERIC_THERMISTORTABLE_1
+const short temptable_generic1[TEMPTABLE_INDEX_ENTRIES] PROGMEM = TEMPTABLE_UNIFORM(GENERIC_TEMPTABLE_ENTRY,1);
+#endif // USE_GENERIC_THERMISTORTABLE_1
+
+#ifdef USE_GENERIC_THERMISTORTABLE_2
+const short temptable_generic2[TEMPTABLE_INDEX_ENTRIES] PROGMEM = TEMPTABLE_UNIFORM(GENERIC_TEMPTABLE_ENTRY,2);
+#endif // USE_GENERIC_THERMISTORTABLE_2
+
+#ifdef USE_GENERIC_THERMISTORTABLE_3
+const short temptable_generic3[TEMPTABLE_INDEX_ENTRIES] PROGMEM = TEMPTABLE_UNIFORM(GENERIC_TEMPTABLE_ENTRY,3);
+#endif // USE_GENERIC_THERMISTORTABLE_3
+
+
 void TemperatureController::updateCurrentTemperature()
 {
     uint8_t type = sensorType;
@@ -843,9 +1140,9 @@ void TemperatureController::updateCurrentTemperature()
         //case 13 weiter unten, E3D PT100.
         case 14: // Thermistor NTC 3950 100k Ohm
         case 15: // Thermistor NTC 3950 100k Ohm
-        case 97: // Define Raw Thermistor and Restistor-Settings within configuration.h see USE_GENERIC_THERMISTORTABLE_1 and GENERIC_THERM_NUM_ENTRIES 
-        case 98: // Define Raw Thermistor and Restistor-Settings within configuration.h see USE_GENERIC_THERMISTORTABLE_2 and GENERIC_THERM_NUM_ENTRIES 
-        case 99: // Define Raw Thermistor and Restistor-Settings within configuration.h see USE_GENERIC_THERMISTORTABLE_3 and GENERIC_THERM_NUM_ENTRIES 
+        case 97: // Define Raw Thermistor and Restistor-Settings within configuration.h see USE_GENERIC_THERMISTORTABLE_1 
+        case 98: // Define Raw Thermistor and Restistor-Settings within configuration.h see USE_GENERIC_THERMISTORTABLE_2 
+        case 99: // Define Raw Thermistor and Restistor-Settings within configuration.h see USE_GENERIC_THERMISTORTABLE_3 
         {
             currentTemperature = (1023<<(2-ANALOG_REDUCE_BITS))-(osAnalogInputValues[sensorPin]>>(ANALOG_REDUCE_BITS)); // Convert to 10 bit result
             break;
@@ -883,117 +1180,56 @@ void TemperatureController::updateCurrentTemperature()
         case 10:
         case 11:
         case 12:
+        case 13: // PT100 E3D
         case 14: // Thermistor NTC 3950 100k Ohm
         case 15: // Thermistor NTC 3950 100k Ohm
-        {
-            type--;
-            uint8_t num = pgm_read_byte(&temptables_num[type])<<1;
-            uint8_t i=2;
-            const short *temptable = (const short *)pgm_read_word(&temptables[type]); //pgm_read_word_near(&temptables[type]);
-            short oldraw = pgm_read_word(&temptable[0]);
-            short oldtemp = pgm_read_word(&temptable[1]);
-            short newtemp = 0;
-            int temp = (1023<<(2-ANALOG_REDUCE_BITS))-currentTemperature;
-
-
-            while(i<num)
-            {
-                short newraw = pgm_read_word(&temptable[i++]);
-                newtemp = pgm_read_word(&temptable[i++]);
-                if (newraw > temp)
-                {
-                    //OUT_P_I("RC O:",oldtemp);OUT_P_I_LN(" OR:",oldraw);
-                    //OUT_P_I("RC N:",newtemp);OUT_P_I_LN(" NR:",newraw);
-                    currentTemperatureC = TEMP_INT_TO_FLOAT(oldtemp + (float)(temp-oldraw)*(float)(newtemp-oldtemp)/(newraw-oldraw));
-
-#if FEATURE_HEAT_BED_TEMP_COMPENSATION
-                    float   offset = getHeatBedTemperatureOffset( currentTemperatureC );
-
-
-#if DEBUG_HEAT_BED_TEMP_COMPENSATION
-                    if( targetTemperatureC > 50 )
-                    {
-                        Com::printF( PSTR( "updateCurrentTemperature().1: " ), currentTemperatureC );
-                        Com::printF( PSTR( ", " ), offset );
-                        Com::printF( PSTR( ", " ), currentTemperature );
-                        Com::printFLN( PSTR( ", " ), targetTemperature );
-                    }
-#endif // DEBUG_HEAT_BED_TEMP_COMPENSATION
-
-                    currentTemperatureC += offset;
-#endif // FEATURE_HEAT_BED_TEMP_COMPENSATION
-
-                    return;
-                }
-                oldtemp = newtemp;
-                oldraw = newraw;
-            }
-            // Overflow: Set to last value in the table
-            currentTemperatureC = TEMP_INT_TO_FLOAT(newtemp);
-
-#if FEATURE_HEAT_BED_TEMP_COMPENSATION
-            float offset = getHeatBedTemperatureOffset( currentTemperatureC );
-
-
-#if DEBUG_HEAT_BED_TEMP_COMPENSATION
-            Com::printF( PSTR( "updateCurrentTemperature().2: " ), currentTemperatureC );
-            Com::printFLN( PSTR( ", " ), offset );
-#endif // DEBUG_HEAT_BED_TEMP_COMPENSATION
-
-            currentTemperatureC += offset;
-#endif // FEATURE_HEAT_BED_TEMP_COMPENSATION
-
-            break;
-        }
-        case 13:
         case 50: // User defined PTC thermistor
         case 51:
         case 52:
         {
-            type-=46;
-            uint8_t num = pgm_read_byte(&temptables_num[type])<<1;
-            uint8_t i=2;
-            const short *temptable = (const short *)pgm_read_word(&temptables[type]); //pgm_read_word_near(&temptables[type]);
-            short oldraw = pgm_read_word(&temptable[0]);
-            short oldtemp = pgm_read_word(&temptable[1]);
-            short newtemp = 0;
-
+            // the tables contain increasing raw values, the raw value of NTC thermistors has been inverted above
+            int raw = (type == 13 || type >= 50) ? currentTemperature : (1023<<(2-ANALOG_REDUCE_BITS))-currentTemperature;
 
-            while(i<num)
-            {
-                short newraw = pgm_read_word(&temptable[i++]);
-                newtemp = pgm_read_word(&temptable[i++]);
-                if (newraw > currentTemperature)
-                {
-                    currentTemperatureC = TEMP_INT_TO_FLOAT(oldtemp + (float)(currentTemperature-oldraw)*(float)(newtemp-oldtemp)/(newraw-oldraw));
+            type = (type >= 50) ? type-46 : type-1;
+            uint8_t num = pgm_read_byte(&temptables_num[type]);
+            const short *temptable = (const short *)pgm_read_word(&temptables[type]);
+            const uint8_t *tempindex = (const uint8_t *)pgm_read_word(&temptables_index[type]);
+            uint8_t i = pgm_read_byte(&tempindex[raw>>TEMPTABLE_INDEX_SHIFT]);
 
-#if FEATURE_HEAT_BED_TEMP_COMPENSATION
-                    float offset = getHeatBedTemperatureOffset( currentTemperatureC );
 
+            while(i<num && (short)pgm_read_word(&temptable[i<<1]) <= raw)
+            {
+                i++;
+            }
 
-#if DEBUG_HEAT_BED_TEMP_COMPENSATION
-                    Com::printF( PSTR( "updateCurrentTemperature().3: " ), currentTemperatureC );
-                    Com::printFLN( PSTR( ", " ), offset );
-#endif // DEBUG_HEAT_BED_TEMP_COMPENSATION
-
-                    currentTemperatureC += offset;
-#endif // FEATURE_HEAT_BED_TEMP_COMPENSATION
+            if(i<num)
+            {
+                short oldraw = pgm_read_word(&temptable[(i<<1)-2]);
+                short oldtemp = pgm_read_word(&temptable[(i<<1)-1]);
+                short newraw = pgm_read_word(&temptable[i<<1]);
+                short newtemp = pgm_read_word(&temptable[(i<<1)+1]);
 
-                    return;
-                }
-                oldtemp = newtemp;
-                oldraw = newraw;
+                // integer interpolation with 4 additional bits of precision
+                currentTemperatureC = TEMP_INT_TO_FLOAT(((long)oldtemp*16 + (long)(raw-oldraw)*(newtemp-oldtemp)*16/(newraw-oldraw))) * (1.0f/16);
+            }
+            else
+            {
+                // Overflow: Set to last value in the table
+                currentTemperatureC = TEMP_INT_TO_FLOAT((short)pgm_read_word(&temptable[(num<<1)-1]));
             }
-            // Overflow: Set to last value in the table
-            currentTemperatureC = TEMP_INT_TO_FLOAT(newtemp);
 
 #if FEATURE_HEAT_BED_TEMP_COMPENSATION
-            float offset = getHeatBedTemperatureOffset( currentTemperatureC );
+            float   offset = getHeatBedTemperatureOffset( currentTemperatureC );
 
 
 #if DEBUG_HEAT_BED_TEMP_COMPENSATION
-            Com::printF( PSTR( "updateCurrentTemperature().4: " ), currentTemperatureC );
-            Com::printFLN( PSTR( ", " ), offset );
+            if( targetTemperatureC > 50 )
+            {
+                Com::printF( PSTR( "updateCurrentTemperature().1: " ), currentTemperatureC );
+                Com::printF( PSTR( ", " ), offset );
+                Com::printF( PSTR( ", " ), currentTemperature );
+                Com::printFLN( PSTR( ", " ), targetTemperature );
+            }
 #endif // DEBUG_HEAT_BED_TEMP_COMPENSATION
 
             currentTemperatureC += offset;
@@ -1040,50 +1276,31 @@ void TemperatureController::updateCurrentTemperature()
         case 98:
         case 99:
         {
-            uint8_t i=2;
-            const short *temptable;
+            const short *temptable = 0;
 
 #ifdef USE_GENERIC_THERMISTORTABLE_1
             if(type == 97)
-                temptable = (const short *)temptable_generic1;
+                temptable = temptable_generic1;
 #endif // USE_GENERIC_THERMISTORTABLE_1
 
 #ifdef USE_GENERIC_THERMISTORTABLE_2
             if(type == 98)
-                temptable = (const short *)temptable_generic2;
+                temptable = temptable_generic2;
 #endif // USE_GENERIC_THERMISTORTABLE_2
 
 #ifdef USE_GENERIC_THERMISTORTABLE_3
             if(type == 99)
-                temptable = (const short *)temptable_generic3;
+                temptable = temptable_generic3;
 #endif // USE_GENERIC_THERMISTORTABLE_3
 
-            short oldraw = temptable[0];
-            short oldtemp = temptable[1];
-            short newraw,newtemp;
-
+            int raw = (1023<<(2-ANALOG_REDUCE_BITS))-currentTemperature;
+            uint8_t index = raw>>TEMPTABLE_INDEX_SHIFT;
+            short lowtemp = pgm_read_word(&temptable[index]);
+            short hightemp = pgm_read_word(&temptable[index+1]);
 
-            currentTemperature = (1023<<(2-ANALOG_REDUCE_BITS))-currentTemperature;
-            while(i<GENERIC_THERM_NUM_ENTRIES*2)
-            {
-                newraw = temptable[i++];
-                newtemp = temptable[i++];
-                if (newraw > currentTemperature)
-                {
-                    //OUT_P_I("RC O:",oldtemp);OUT_P_I_LN(" OR:",oldraw);
-                    //OUT_P_I("RC N:",newtemp);OUT_P_I_LN(" NR:",newraw);
-                    currentTemperatureC = TEMP_INT_TO_FLOAT(oldtemp + (float)(currentTemperature-oldraw)*(float)(newtemp-oldtemp)/(newraw-oldraw));
 
-#if FEATURE_HEAT_BED_TEMP_COMPENSATION
-                    currentTemperatureC += getHeatBedTemperatureOffset( currentTemperatureC );
-#endif // FEATURE_HEAT_BED_TEMP_COMPENSATION
-                    return;
-                }
-                oldtemp = newtemp;
-                oldraw = newraw;
-            }
-            // Overflow: Set to last value in the table
-            currentTemperatureC = TEMP_INT_TO_FLOAT(newtemp);
+            // the generic tables are uniformly spaced, so one integer interpolation between two neighboured entries is sufficient
+            currentTemperatureC = TEMP_INT_TO_FLOAT((long)lowtemp*(1<<TEMPTABLE_INDEX_SHIFT) + (long)(hightemp-lowtemp)*(raw & ((1<<TEMPTABLE_INDEX_SHIFT)-1))) * (1.0f/(1<<TEMPTABLE_INDEX_SHIFT));
 
 #if FEATURE_HEAT_BED_TEMP_COMPENSATION
             currentTemperatureC += getHeatBedTemperatureOffset( currentTemperatureC );
@@ -1169,7 +1386,7 @@ void TemperatureController::setTargetTemperature(float target, float offset)
         case 51:
         case 52:
         {
-            type-=46;
+            type = (type == 13) ? 12 : type-46;
             uint8_t num = pgm_read_byte(&temptables_num[type])<<1;
             uint8_t i=2;
             const short *temptable = (const short *)pgm_read_word(&temptables[type]); //pgm_read_word(&temptables[type]);
@@ -1225,49 +1442,39 @@ void TemperatureController::setTargetTemperature(float target, float offset)
         case 98:
         case 99:
         {
-            uint8_t i=2;
-            const short *temptable;
+            uint8_t i=1;
+            const short *temptable = 0;
 
 #ifdef USE_GENERIC_THERMISTORTABLE_1
             if(type == 97)
-                temptable = (const short *)temptable_generic1;
+                temptable = temptable_generic1;
 #endif // USE_GENERIC_THERMISTORTABLE_1
 
 #ifdef USE_GENERIC_THERMISTORTABLE_2
             if(type == 98)
-                temptable = (const short *)temptable_generic2;
+                temptable = temptable_generic2;
 #endif // USE_GENERIC_THERMISTORTABLE_2
 
 #ifdef USE_GENERIC_THERMISTORTABLE_3
             if(type == 99)
-                temptable = (const short *)temptable_generic3;
+                temptable = temptable_generic3;
 #endif // USE_GENERIC_THERMISTORTABLE_3
 
-            short oldraw = temptable[0];
-            short oldtemp = temptable[1];
-            short newraw = 0;
-            while(i<GENERIC_THERM_NUM_ENTRIES*2)
+            short oldtemp = pgm_read_word(&temptable[0]);
+            while(i<TEMPTABLE_INDEX_ENTRIES)
             {
-                newraw = temptable[i++];
-                short newtemp = temptable[i++];
+                short newtemp = pgm_read_word(&temptable[i]);
                 if (newtemp < temp)
                 {
-                    targetTemperature = (1023<<(2-ANALOG_REDUCE_BITS))- oldraw + (int32_t)(oldtemp-temp)*(int32_t)(oldraw-newraw)/(oldtemp-newtemp);
-
-#if FEATURE_HEAT_BED_TEMP_COMPENSATION
-                    currentTemperatureC += getHeatBedTemperatureOffset( currentTemperatureC );
-#endif // FEATURE_HEAT_BED_TEMP_COMPENSATION
+                    short oldraw = (i-1)<<TEMPTABLE_INDEX_SHIFT;
+                    targetTemperature = (1023<<(2-ANALOG_REDUCE_BITS))- oldraw - (int32_t)(oldtemp-temp)*(int32_t)(1<<TEMPTABLE_INDEX_SHIFT)/(oldtemp-newtemp);
                     return;
                 }
                 oldtemp = newtemp;
-                oldraw = newraw;
+                i++;
             }
             // Overflow: Set to last value in the table
-            targetTemperature = (1023<<(2-ANALOG_REDUCE_BITS))-newraw;
-
-#if FEATURE_HEAT_BED_TEMP_COMPENSATION
-            currentTemperatureC += getHeatBedTemperatureOffset( currentTemperatureC );
-#endif // FEATURE_HEAT_BED_TEMP_COMPENSATION
+            targetTemperature = 0;
             break;
         }
 #endif
@@ -1295,6 +1502,75 @@ void Extruder::disableAllHeater()
 
 } // disableAllHeater
 
+#if FEATURE_HEATUP_ETA
+/** \brief Estimates the time until the target temperature is reached. This is called every 100 ms.
+The heat-up is predicted with the thermal model of the heater at full power. The heating rate of the model is corrected by the ratio of the observed and the
+expected heating rate, which is learned while the heater runs at full power. Without thermal model, the remaining error is divided by the observed rate. */
+void TemperatureController::updateHeatUpEta()
+{
+    float   error = targetTemperatureC - currentTemperatureC;
+    float   rate  = (currentTemperatureC - tempArray[tempPointer]) * 0.666f;     // temperature change within the last 1.5 s [°C/s]
+    float   eta   = -1;
+
+
+    heatUpRate = heatUpRate * 0.9f + rate * 0.1f;
+
+    if( targetTemperatureC < 20.0f || fabs(error) <= TEMP_TOLERANCE )
+    {
+        heatUpEta = 0;
+        return;
+    }
+
+#if FEATURE_HEAT_MODEL_CONTROL
+    if( modelHeatRate > 0 && modelLossRate > 0 )
+    {
+        float   ambient = HEATER_MODEL_AMBIENT_TEMPERATURE;
+
+        if( error > 0 )
+        {
+            float   expected = modelHeatRate * pwm_pos[pwmIndex] / 255.0f - modelLossRate * (currentTemperatureC - ambient);
+            float   goal     = targetTemperatureC - TEMP_TOLERANCE;
+            float   limit;
+
+
+            if( error > PID_CONTROL_RANGE && expected > 0.1f && heatUpRate > 0 )
+            {
+                // learn how fast the heater really heats compared to the model (supply voltage, power budget, model errors)
+                float   ratio = constrain(heatUpRate / expected, 0.5f, 2.0f);
+                heatUpCorrection = heatUpCorrection ? heatUpCorrection * 0.95f + ratio * 0.05f : ratio;
+            }
+
+            // the temperature which would be reached with full power
+            limit = ambient + (heatUpCorrection ? heatUpCorrection : 1.0f) * modelHeatRate * pidMax / (255.0f * modelLossRate);
+            if( limit > goal + 0.5f )
+            {
+                eta = log( (limit - currentTemperatureC) / (limit - goal) ) / modelLossRate;
+            }
+        }
+        else
+        {
+            // the heater is off, the temperature decays towards the ambient temperature
+            float   goal = targetTemperatureC + TEMP_TOLERANCE;
+
+            if( goal > ambient + 0.5f )
+            {
+                eta = log( (currentTemperatureC - ambient) / (goal - ambient) ) / modelLossRate;
+            }
+        }
+    }
+#endif // FEATURE_HEAT_MODEL_CONTROL
+
+    if( eta < 0 && heatUpRate * error > 0 && fabs(heatUpRate) > 0.02f )
+    {
+        eta = (fabs(error) - TEMP_TOLERANCE) / fabs(heatUpRate);
+    }
+
+    heatUpEta = (eta < 0 ? -1 : (int16_t)RMath::min(eta + 0.5f, 32767.0f));
+
+} // updateHeatUpEta
+#endif // FEATURE_HEATUP_ETA
+
+
 void TemperatureController::waitForTargetTemperature() {
     if(targetTemperatureC < 30) return;
     if(Printer::debugDryrun()) return;
@@ -1332,6 +1608,11 @@ void TemperatureController::autotunePID(float temp, uint8_t controllerId, int ma
     float Ku, Tu;
     float Kp = 0, Ki = 0, Kd = 0;
     float maxTemp=20, minTemp=20; 
+    if(method == 7) //step response model
+    {
+        identifyModel(temp, controllerId, storeValues);
+        return;
+    }
     if(maxCycles < 5)
         maxCycles = 5;
     if(maxCycles > 20)
@@ -1522,6 +1803,185 @@ see also: http://www.mstarlabs.com/control/znrule.html
     }
 } // autotunePID
 
+
+/** \brief Identifies the heater with a single step of the heater output.
+The heater is driven with pidMax from its current temperature up to temp. The heating rate and the loss rate are fitted by a linear regression of the
+temperature rise over the temperature (dT/dt = heat rate - loss rate * (T - ambient)) after the point of the steepest rise, the dead time is the delay of the
+measured temperature against this first order model. The PID gains are derived from the model (SIMC rules). */
+void TemperatureController::identifyModel(float temp, uint8_t controllerId, bool storeValues)
+{
+    float       samples[5];
+    uint8_t     sampleCount = 0;
+    float       startTemp;
+    float       maxRaising = 0;
+    float       n = 0, sumX = 0, sumY = 0, sumXX = 0, sumXY = 0;
+    float       heatRate, lossRate, deadTime, riseTime;
+    float       Kp, Ki, Kd;
+    int16_t     driveMax;
+
+
+    Com::printInfoFLN(Com::tPIDAutotuneStart);
+    Com::printF( PSTR("Ruleset: "), 7 );
+    Com::printFLN(Com::tAPIDStepResponse);
+
+    updateCurrentTemperature();
+    startTemp = currentTemperatureC;
+    if(startTemp > temp - 20)
+    {
+        Com::printErrorFLN(Com::tAPIDFailedModel);
+        showError( (void*)ui_text_autodetect_pid, (void*)ui_text_temperature_wrong );
+        return;
+    }
+
+    autotuneIndex = controllerId;
+    pwm_pos[pwmIndex] = pidMax;
+    if(controllerId<NUM_EXTRUDER)
+    {
+        extruder[controllerId].coolerPWM = extruder[controllerId].coolerSpeed;
+        extruder[0].coolerPWM = extruder[0].coolerSpeed;
+    }
+
+    millis_t startTime  = HAL::timeInMilliseconds();
+    millis_t sampleTime = startTime;
+
+    for(;;)
+    {
+        Commands::checkForPeriodicalActions();
+        GCode::keepAlive( WaitHeater );
+        updateCurrentTemperature();
+
+        millis_t time = HAL::timeInMilliseconds();
+        if(time - sampleTime >= 1000)
+        {
+            // the temperature rise is taken over 4 s around the middle sample in order to suppress the noise of the measurement
+            sampleTime += 1000;
+            for(uint8_t i=0; i<4; i++) samples[i] = samples[i+1];
+            samples[4] = currentTemperatureC;
+            if(sampleCount < 5) sampleCount++;
+
+            if(sampleCount == 5)
+            {
+                float raising = (samples[4] - samples[0]) * 0.25f;
+                float x       = samples[2] - startTemp;
+
+                if(raising > maxRaising)
+                {
+                    // the step response of the real heater is not yet in its first order part
+                    maxRaising = raising;
+                    n = sumX = sumY = sumXX = sumXY = 0;
+                }
+                else
+                {
+                    n     += 1;
+                    sumX  += x;
+                    sumY  += raising;
+                    sumXX += x * x;
+                    sumXY += x * raising;
+                }
+            }
+
+            if(currentTemperatureC >= temp)
+            {
+                break;
+            }
+        }
+
+        if(currentTemperatureC > (temp + 40))
+        {
+            Com::printErrorFLN(Com::tAPIDFailedHigh);
+            showError( (void*)ui_text_autodetect_pid, (void*)ui_text_temperature_wrong );
+            pwm_pos[pwmIndex] = 0;
+            autotuneIndex = 255;
+            return;
+        }
+
+        Commands::printTemperatures();
+
+        if(time - startTime > (10L*60L*1000L*2L))   // 20 Minutes
+        {
+            Com::printErrorFLN(Com::tAPIDFailedTimeout);
+            showError( (void*)ui_text_autodetect_pid, (void*)ui_text_timeout );
+            pwm_pos[pwmIndex] = 0;
+            autotuneIndex = 255;
+            return;
+        }
+        UI_MEDIUM;
+        UI_SLOW;
+    }
+    pwm_pos[pwmIndex] = 0;
+    autotuneIndex = 255;
+
+    riseTime = (float)(sampleTime - startTime) * 0.001f;
+    float denominator = n * sumXX - sumX * sumX;
+    if(n < 10 || denominator <= 0)
+    {
+        Com::printErrorFLN(Com::tAPIDFailedModel);
+        showError( (void*)ui_text_autodetect_pid, (void*)ui_text_temperature_wrong );
+        return;
+    }
+
+    lossRate = RMath::max(-(n * sumXY - sumX * sumY) / denominator, 0.0f);
+    heatRate = (sumY + lossRate * sumX) / n;                                   // at the start temperature
+    if(heatRate <= 0)
+    {
+        Com::printErrorFLN(Com::tAPIDFailedModel);
+        showError( (void*)ui_text_autodetect_pid, (void*)ui_text_temperature_wrong );
+        return;
+    }
+
+    // the time which the first order model needs from the start temperature to the last sample, the rest is dead time
+    float rise = samples[4] - startTemp;
+    if(lossRate * rise >= heatRate * 0.99f)
+    {
+        Com::printErrorFLN(Com::tAPIDFailedModel);
+        showError( (void*)ui_text_autodetect_pid, (void*)ui_text_temperature_wrong );
+        return;
+    }
+    if(lossRate > 0.00001f)
+        deadTime = riseTime + log(1.0f - lossRate * rise / heatRate) / lossRate;
+    else
+        deadTime = riseTime - rise / heatRate;
+    deadTime = RMath::max(deadTime, 0.5f);
+
+    heatRate = (heatRate + lossRate * (startTemp - HEATER_MODEL_AMBIENT_TEMPERATURE)) * 255.0f / (float)pidMax;   // at the ambient temperature and full power
+
+    Kp       = 255.0f / (heatRate * 2.0f * deadTime);
+    Ki       = Kp / (lossRate > 0 ? RMath::min(1.0f / lossRate, 8.0f * deadTime) : 8.0f * deadTime);
+    Kd       = Kp * deadTime * 0.5f;
+    driveMax = (int16_t)(1.25f * 255.0f * lossRate * (temp - HEATER_MODEL_AMBIENT_TEMPERATURE) / heatRate);
+    driveMax = constrain(driveMax, (int16_t)pidDriveMin + 1, (int16_t)pidMax);
+
+    Com::printF(Com::tAPIDHeatRate,heatRate,3);
+    Com::printF(Com::tAPIDLossRate,lossRate,5);
+    Com::printFLN(Com::tAPIDDeadTime,deadTime,1);
+    Com::printFLN(Com::tAPIDKp,Kp);
+    Com::printFLN(Com::tAPIDKi,Ki);
+    Com::printFLN(Com::tAPIDKd,Kd);
+    Com::printFLN(Com::tAPIDDriveMax,(int)driveMax);
+    Com::printInfoFLN(Com::tAPIDFinished);
+    UI_STATUS_UPD( UI_TEXT_AUTODETECT_PID_DONE );
+
+    if(storeValues)
+    {
+        pidPGain    = Kp;
+        pidIGain    = Ki;
+        pidDGain    = Kd;
+        pidDriveMax = (uint8_t)driveMax;
+
+#if FEATURE_HEAT_MODEL_CONTROL
+        modelHeatRate = heatRate;
+        modelLossRate = lossRate;
+        modelDeadTime = deadTime;
+        if(heatManager != 4) heatManager = 1; //HTR_PID / activate PID MANAGER, unless the model based control is used
+#else
+        heatManager = 1; //HTR_PID / activate PID MANAGER
+#endif // FEATURE_HEAT_MODEL_CONTROL
+        updateTempControlVars();
+        EEPROM::storeDataIntoEEPROM();
+    }
+
+} // identifyModel
+
 bool reportTempsensorError()
 {
     if(!Printer::isAnyTempsensorDefect()) return false;
@@ -1626,7 +2086,11 @@ Extruder extruder[NUM_EXTRUDER] =
 
             0,EXT0_HEAT_MANAGER
             ,0,EXT0_PID_INTEGRAL_DRIVE_MAX,EXT0_PID_INTEGRAL_DRIVE_MIN,EXT0_PID_P,EXT0_PID_I,EXT0_PID_D,EXT0_PID_MAX,0,0,0,{0,0,0,0}
-        ,0}
+        ,0
+#if FEATURE_HEAT_MODEL_CONTROL
+        ,HEATER_MODEL_EXTRUDER_HEAT_RATE,HEATER_MODEL_EXTRUDER_LOSS_RATE,HEATER_MODEL_EXTRUDER_DEAD_TIME,0,0,0,0,0,0
+#endif // FEATURE_HEAT_MODEL_CONTROL
+        }
         ,ext0_select_cmd,ext0_deselect_cmd,EXT0_EXTRUDER_COOLER_SPEED,0
 #if STEPPER_ON_DELAY
         , '\x0'
@@ -1659,7 +2123,11 @@ Extruder extruder[NUM_EXTRUDER] =
 
             0,EXT1_HEAT_MANAGER
             ,0,EXT1_PID_INTEGRAL_DRIVE_MAX,EXT1_PID_INTEGRAL_DRIVE_MIN,EXT1_PID_P,EXT1_PID_I,EXT1_PID_D,EXT1_PID_MAX,0,0,0,{0,0,0,0}
-        ,0}
+        ,0
+#if FEATURE_HEAT_MODEL_CONTROL
+        ,HEATER_MODEL_EXTRUDER_HEAT_RATE,HEATER_MODEL_EXTRUDER_LOSS_RATE,HEATER_MODEL_EXTRUDER_DEAD_TIME,0,0,0,0,0,0
+#endif // FEATURE_HEAT_MODEL_CONTROL
+        }
         ,ext1_select_cmd,ext1_deselect_cmd,EXT1_EXTRUDER_COOLER_SPEED,0
 #if STEPPER_ON_DELAY
         , '\x0'
@@ -1686,7 +2154,11 @@ Extruder extruder[NUM_EXTRUDER] =
         ,{
             2,EXT2_TEMPSENSOR_TYPE,EXT2_SENSOR_INDEX,0,0,0,0,0,EXT2_HEAT_MANAGER
             ,0,EXT2_PID_INTEGRAL_DRIVE_MAX,EXT2_PID_INTEGRAL_DRIVE_MIN,EXT2_PID_P,EXT2_PID_I,EXT2_PID_D,EXT2_PID_MAX,0,0,0,{0,0,0,0}
-        ,0}
+        ,0
+#if FEATURE_HEAT_MODEL_CONTROL
+        ,HEATER_MODEL_EXTRUDER_HEAT_RATE,HEATER_MODEL_EXTRUDER_LOSS_RATE,HEATER_MODEL_EXTRUDER_DEAD_TIME,0,0,0,0,0,0
+#endif // FEATURE_HEAT_MODEL_CONTROL
+        }
         ,ext2_select_cmd,ext2_deselect_cmd,EXT2_EXTRUDER_COOLER_SPEED,0
 #if STEPPER_ON_DELAY
         , '\x0'
@@ -1714,7 +2186,11 @@ Extruder extruder[NUM_EXTRUDER] =
             3,EXT3_TEMPSENSOR_TYPE,EXT3_SENSOR_INDEX,0,0,0,0,0,EXT3_HEAT_MANAGER
             ,0,EXT3_PID_INTEGRAL_DRIVE_MAX,EXT3_PID_INTEGRAL_DRIVE_MIN,EXT3_PID_P,EXT3_PID_I,EXT3_PID_D,EXT3_PID_MAX,0,0,0,{0,0,0,0}
 
-        ,0}
+        ,0
+#if FEATURE_HEAT_MODEL_CONTROL
+        ,HEATER_MODEL_EXTRUDER_HEAT_RATE,HEATER_MODEL_EXTRUDER_LOSS_RATE,HEATER_MODEL_EXTRUDER_DEAD_TIME,0,0,0,0,0,0
+#endif // FEATURE_HEAT_MODEL_CONTROL
+        }
         ,ext3_select_cmd,ext3_deselect_cmd,EXT3_EXTRUDER_COOLER_SPEED,0
 #if STEPPER_ON_DELAY
         , '\x0'
@@ -1741,7 +2217,11 @@ Extruder extruder[NUM_EXTRUDER] =
         ,{
             4,EXT4_TEMPSENSOR_TYPE,EXT4_SENSOR_INDEX,0,0,0,0,0,EXT4_HEAT_MANAGER
             ,0,EXT4_PID_INTEGRAL_DRIVE_MAX,EXT4_PID_INTEGRAL_DRIVE_MIN,EXT4_PID_P,EXT4_PID_I,EXT4_PID_D,EXT4_PID_MAX,0,0,0,{0,0,0,0}
-        ,0}
+        ,0
+#if FEATURE_HEAT_MODEL_CONTROL
+        ,HEATER_MODEL_EXTRUDER_HEAT_RATE,HEATER_MODEL_EXTRUDER_LOSS_RATE,HEATER_MODEL_EXTRUDER_DEAD_TIME,0,0,0,0,0,0
+#endif // FEATURE_HEAT_MODEL_CONTROL
+        }
         ,ext4_select_cmd,ext4_deselect_cmd,EXT4_EXTRUDER_COOLER_SPEED,0
 #if STEPPER_ON_DELAY
         , '\x0'
@@ -1768,7 +2248,11 @@ Extruder extruder[NUM_EXTRUDER] =
         ,{
             5,EXT5_TEMPSENSOR_TYPE,EXT5_SENSOR_INDEX,0,0,0,0,0,EXT5_HEAT_MANAGER
             ,0,EXT5_PID_INTEGRAL_DRIVE_MAX,EXT5_PID_INTEGRAL_DRIVE_MIN,EXT5_PID_P,EXT5_PID_I,EXT5_PID_D,EXT5_PID_MAX,0,0,0,{0,0,0,0}
-        ,0}
+        ,0
+#if FEATURE_HEAT_MODEL_CONTROL
+        ,HEATER_MODEL_EXTRUDER_HEAT_RATE,HEATER_MODEL_EXTRUDER_LOSS_RATE,HEATER_MODEL_EXTRUDER_DEAD_TIME,0,0,0,0,0,0
+#endif // FEATURE_HEAT_MODEL_CONTROL
+        }
         ,ext5_select_cmd,ext5_deselect_cmd,EXT5_EXTRUDER_COOLER_SPEED,0
 #if STEPPER_ON_DELAY
         , '\x0'
@@ -1788,7 +2272,11 @@ TemperatureController heatedBedController = {NUM_EXTRUDER,HEATED_BED_SENSOR_TYPE
 #endif // FEATURE_HEAT_BED_TEMP_COMPENSATION
         0,HEATED_BED_HEAT_MANAGER
         ,0,HEATED_BED_PID_INTEGRAL_DRIVE_MAX,HEATED_BED_PID_INTEGRAL_DRIVE_MIN,HEATED_BED_PID_PGAIN,HEATED_BED_PID_IGAIN,HEATED_BED_PID_DGAIN,HEATED_BED_PID_MAX,0,0,0,{0,0,0,0}
-        ,0};
+        ,0
+#if FEATURE_HEAT_MODEL_CONTROL
+        ,HEATER_MODEL_BED_HEAT_RATE,HEATER_MODEL_BED_LOSS_RATE,HEATER_MODEL_BED_DEAD_TIME,0,0,0,0,0,0
+#endif // FEATURE_HEAT_MODEL_CONTROL
+        };
 #else
 #define NUM_TEMPERATURE_LOOPS NUM_EXTRUDER
 #endif // HAVE_HEATED_BED
@@ -1807,7 +2295,11 @@ TemperatureController optTempController = {0,RESERVE_ANALOG_SENSOR_TYPE,RESERVE_
 #endif // FEATURE_HEAT_BED_TEMP_COMPENSATION
         0, 0
         ,0,0,0,0,0,0,0,0,0,0,{0,0,0,0}
-        ,0};
+        ,0
+#if FEATURE_HEAT_MODEL_CONTROL
+        ,0,0,0,0,0,0,0,0,0
+#endif // FEATURE_HEAT_MODEL_CONTROL
+        };
 #endif // RESERVE_ANALOG_INPUTS
 
 
@@ -49,7 +49,7 @@ public:
 #endif // FEATURE_HEAT_BED_TEMP_COMPENSATION
 
     uint32_t    lastTemperatureUpdate;  ///< Time in millis of the last temperature update.
-    int8_t      heatManager;            ///< How is temperature controled. 0 = on/off, 1 = PID-Control, 3 = dead time control
+    int8_t      heatManager;            ///< How is temperature controled. 0 = on/off, 1 = PID-Control, 3 = dead time control, 4 = model based control
 
     float       tempIState;             ///< Temp. var. for PID computation.
     uint8_t     pidDriveMax;            ///< Used for windup in PID calculation.
@@ -65,13 +65,38 @@ public:
 
     uint8_t     flags;
 
+#if FEATURE_HEAT_MODEL_CONTROL
+    float       modelHeatRate;          ///< Heating rate at full heater power [°C/s] (heater power / heat capacity).
+    float       modelLossRate;          ///< Loss rate [1/s] (loss coefficient / heat capacity).
+    float       modelDeadTime;          ///< Dead time between heater and temperature sensor [s].
+    uint16_t    modelFeedForward;       ///< Heater output per °C above ambient which holds the temperature [1/256 PWM units].
+    uint16_t    modelPGain;             ///< Proportional gain of the residual control [1/256 PWM units per °C].
+    uint16_t    modelIGain;             ///< Integral gain of the residual control per 100 ms [1/65536 PWM units per °C].
+    uint16_t    modelPrediction;        ///< Dead time relative to the 1.5 s span of tempArray [1/256].
+    int32_t     modelIState;            ///< Integrated error of the residual control [1/16 °C].
+    int32_t     modelIStateLimit;
+#endif // FEATURE_HEAT_MODEL_CONTROL
+
+#if FEATURE_HEATUP_ETA
+    float       heatUpRate;             ///< Filtered observed temperature change [°C/s].
+    float       heatUpCorrection;       ///< Observed heating rate relative to the heating rate of the thermal model, 0 = not known yet.
+    int16_t     heatUpEta;              ///< Estimated time until the target temperature is reached [s], 0 = reached or no target, -1 = not known yet.
+#endif // FEATURE_HEATUP_ETA
+
     void setTargetTemperature(float target, float offset);
     void updateCurrentTemperature();
     void updateTempControlVars();
     inline bool isAlarm() {return flags & TEMPERATURE_CONTROLLER_FLAG_ALARM;}
     inline void setAlarm(bool on) {if(on) flags |= TEMPERATURE_CONTROLLER_FLAG_ALARM; else flags &= ~TEMPERATURE_CONTROLLER_FLAG_ALARM;}
     void waitForTargetTemperature();
+#if FEATURE_HEATUP_ETA
+    void updateHeatUpEta();
+#endif // FEATURE_HEATUP_ETA
+#if FEATURE_HEATER_POWER_BUDGET
+    void limitIntegralState(uint8_t excess);
+#endif // FEATURE_HEATER_POWER_BUDGET
     void autotunePID(float temp, uint8_t controllerId, int maxCycles, bool storeResult, int method);
+    void identifyModel(float temp, uint8_t controllerId, bool storeResult);
 }; // TemperatureController
 
 
@@ -401,6 +426,9 @@ class Extruder   // Size: 12*1 Byte+12*4 Byte+4*2Byte = 68 Byte
 
     } // enable
     static void manageTemperatures();
+#if FEATURE_HEATER_POWER_BUDGET
+    static void applyPowerBudget();
+#endif // FEATURE_HEATER_POWER_BUDGET
     static void disableCurrentExtruderMotor();
     static void disableAllExtruders();
     static void selectExtruderById(uint8_t extruderId);
@@ -379,7 +379,24 @@ void HAL::analogStart() {
         osAnalogInputCounter[i] = 0;
         osAnalogInputBuildup[i] = 0;
         osAnalogInputValues[i] = 0;
+#if FEATURE_ADC_INTERRUPT
+        osAnalogInputFiltered[i] = 0;
+        osAnalogInputUpdates[i] = 0;
+#endif // FEATURE_ADC_INTERRUPT
     }
+
+#if FEATURE_ADC_INTERRUPT
+    // the extruders are sampled ANALOG_INPUT_EXTRUDER_WEIGHT times per round, all other analog inputs once
+    osAnalogInputSlots = 0;
+    for(uint8_t round=0; round<ANALOG_INPUT_EXTRUDER_WEIGHT; round++) {
+        for(uint8_t i=0; i<ANALOG_INPUTS; i++) {
+            if(round == 0 || i < EXT0_ANALOG_INPUTS+EXT1_ANALOG_INPUTS)
+                osAnalogInputSchedule[osAnalogInputSlots++] = i;
+        }
+    }
+    osAnalogInputSlot = 0;
+    osAnalogInputPos = osAnalogInputSchedule[0];
+#endif // FEATURE_ADC_INTERRUPT
     ADCSRA = _BV(ADEN) | _BV(ADSC) | ANALOG_PRESCALER;
     //ADCSRA |= _BV(ADSC);                  // start ADC-conversion
     while (ADCSRA & _BV(ADSC) ) {} // wait for conversion
@@ -398,7 +415,12 @@ void HAL::analogStart() {
 #endif // defined(ADCSRB) && defined(MUX5)
 
     ADMUX = (ADMUX & ~(0x1F)) | (channel & 7);
+
+#if FEATURE_ADC_INTERRUPT
+    ADCSRA |= _BV(ADIE) | _BV(ADSC); // start conversion, the next ones are started by the ADC interrupt
+#else
     ADCSRA |= _BV(ADSC); // start conversion without interrupt!
+#endif // FEATURE_ADC_INTERRUPT
 #endif // ANALOG_INPUTS>0
 
 } // analogStart
@@ -924,6 +946,118 @@ uint8_t cooler_pwm_mask = COOLER_PWM_MASK; //(255 << cooler_pwm_speed) & 0xff
 uint8_t cooler_mode = COOLER_MODE_PWM;
 
 #define pulseDensityModulate(pin, density, error, invert) {uint8_t carry;carry = error + (invert ? 255 - density : density); WRITE(pin, (carry < error)); error = carry;}
+
+#if FEATURE_PWM_PORT_TABLE
+#define _HEATER_PWM_PORT(IO)    (&DIO ## IO ## _WPORT)
+#define HEATER_PWM_PORT(IO)     _HEATER_PWM_PORT(IO)
+#define _HEATER_PWM_BIT(IO)     MASK(DIO ## IO ## _PIN)
+#define HEATER_PWM_BIT(IO)      _HEATER_PWM_BIT(IO)
+
+struct HeaterPWMChannel
+{
+    volatile uint8_t*   port;
+    uint8_t             mask;
+    uint8_t             index;      // index into pwm_pos[]
+};
+
+struct HeaterPWMEdge
+{
+    uint8_t             count;
+    volatile uint8_t*   port;
+    uint8_t             mask;
+};
+
+/** \brief Port and bit of every heater, resolved at compile time from the pin definitions */
+static const HeaterPWMChannel heaterPWMChannels[] =
+{
+#if EXT0_HEATER_PIN>-1
+    { HEATER_PWM_PORT(EXT0_HEATER_PIN), HEATER_PWM_BIT(EXT0_HEATER_PIN), 0 },
+#endif // EXT0_HEATER_PIN>-1
+#if defined(EXT1_HEATER_PIN) && EXT1_HEATER_PIN>-1 && NUM_EXTRUDER>1
+    { HEATER_PWM_PORT(EXT1_HEATER_PIN), HEATER_PWM_BIT(EXT1_HEATER_PIN), 1 },
+#endif // defined(EXT1_HEATER_PIN) && EXT1_HEATER_PIN>-1 && NUM_EXTRUDER>1
+#if defined(EXT2_HEATER_PIN) && EXT2_HEATER_PIN>-1 && NUM_EXTRUDER>2
+    { HEATER_PWM_PORT(EXT2_HEATER_PIN), HEATER_PWM_BIT(EXT2_HEATER_PIN), 2 },
+#endif // defined(EXT2_HEATER_PIN) && EXT2_HEATER_PIN>-1 && NUM_EXTRUDER>2
+#if defined(EXT3_HEATER_PIN) && EXT3_HEATER_PIN>-1 && NUM_EXTRUDER>3
+    { HEATER_PWM_PORT(EXT3_HEATER_PIN), HEATER_PWM_BIT(EXT3_HEATER_PIN), 3 },
+#endif // defined(EXT3_HEATER_PIN) && EXT3_HEATER_PIN>-1 && NUM_EXTRUDER>3
+#if defined(EXT4_HEATER_PIN) && EXT4_HEATER_PIN>-1 && NUM_EXTRUDER>4
+    { HEATER_PWM_PORT(EXT4_HEATER_PIN), HEATER_PWM_BIT(EXT4_HEATER_PIN), 4 },
+#endif // defined(EXT4_HEATER_PIN) && EXT4_HEATER_PIN>-1 && NUM_EXTRUDER>4
+#if defined(EXT5_HEATER_PIN) && EXT5_HEATER_PIN>-1 && NUM_EXTRUDER>5
+    { HEATER_PWM_PORT(EXT5_HEATER_PIN), HEATER_PWM_BIT(EXT5_HEATER_PIN), 5 },
+#endif // defined(EXT5_HEATER_PIN) && EXT5_HEATER_PIN>-1 && NUM_EXTRUDER>5
+#if HEATED_BED_HEATER_PIN>-1 && HAVE_HEATED_BED
+    { HEATER_PWM_PORT(HEATED_BED_HEATER_PIN), HEATER_PWM_BIT(HEATED_BED_HEATER_PIN), NUM_EXTRUDER },
+#endif // HEATED_BED_HEATER_PIN>-1 && HAVE_HEATED_BED
+};
+
+#define HEATER_PWM_CHANNELS     (sizeof(heaterPWMChannels) / sizeof(heaterPWMChannels[0]))
+
+static HeaterPWMEdge    heaterPWMOnEdges[HEATER_PWM_CHANNELS];     // switched on at the start of each period, one entry per port
+static HeaterPWMEdge    heaterPWMOffEdges[HEATER_PWM_CHANNELS];    // switched off during the period, sorted by count, one entry per count and port
+static uint8_t          heaterPWMOnEdgeCount = 0;
+static uint8_t          heaterPWMOffEdgeCount = 0;
+
+
+/** \brief Rebuilds the switching edges of the heaters from the latched duty cycles. This is called only when a duty cycle has changed. */
+static void buildHeaterPWMEdges( const uint8_t* dutyCycles )
+{
+    uint8_t i, j, k;
+
+    heaterPWMOnEdgeCount  = 0;
+    heaterPWMOffEdgeCount = 0;
+
+    for( i = 0; i < HEATER_PWM_CHANNELS; i++ )
+    {
+        uint8_t             duty = dutyCycles[heaterPWMChannels[i].index];
+        volatile uint8_t*   port = heaterPWMChannels[i].port;
+        uint8_t             mask = heaterPWMChannels[i].mask;
+
+        if( duty )
+        {
+            for( j = 0; j < heaterPWMOnEdgeCount && heaterPWMOnEdges[j].port != port; j++ ) ;
+            if( j == heaterPWMOnEdgeCount )
+            {
+                heaterPWMOnEdges[j].count = 0;
+                heaterPWMOnEdges[j].port  = port;
+                heaterPWMOnEdges[j].mask  = 0;
+                heaterPWMOnEdgeCount ++;
+            }
+            heaterPWMOnEdges[j].mask |= mask;
+
+            if( duty == HEATER_PWM_MASK )
+            {
+                // this heater stays on for the whole period
+                continue;
+            }
+        }
+
+        // a heater without duty cycle gets its off edge at count 0, right after the on edges of the period start
+        for( j = 0; j < heaterPWMOffEdgeCount && heaterPWMOffEdges[j].count < duty; j++ ) ;
+        for( k = j; k < heaterPWMOffEdgeCount && heaterPWMOffEdges[k].count == duty && heaterPWMOffEdges[k].port != port; k++ ) ;
+        if( k < heaterPWMOffEdgeCount && heaterPWMOffEdges[k].count == duty )
+        {
+            // another heater at the same port is switched off at the same time
+            heaterPWMOffEdges[k].mask |= mask;
+            continue;
+        }
+
+        for( k = heaterPWMOffEdgeCount; k > j; k-- )
+        {
+            heaterPWMOffEdges[k] = heaterPWMOffEdges[k-1];
+        }
+        heaterPWMOffEdges[j].count = duty;
+        heaterPWMOffEdges[j].port  = port;
+        heaterPWMOffEdges[j].mask  = mask;
+        heaterPWMOffEdgeCount ++;
+    }
+    return;
+
+} // buildHeaterPWMEdges
+#endif // FEATURE_PWM_PORT_TABLE
+
 /**
 This timer is called 3906 times per second. It is used to update pwm values for heater and some other frequent jobs.
 */
@@ -937,6 +1071,45 @@ ISR(PWM_TIMER_VECTOR)
 #endif
     PWM_OCR += 64;
     
+#if FEATURE_PWM_PORT_TABLE
+    static uint8_t heaterPWMNextOffEdge = 0;
+
+    if(pwm_count_heater == 0)
+    {
+        bool changed = false;
+        for(uint8_t i = 0; i < HEATER_PWM_CHANNELS; i++)
+        {
+            uint8_t index = heaterPWMChannels[i].index;
+            uint8_t duty  = pwm_pos[index] & HEATER_PWM_MASK;
+            if(pwm_pos_set[index] != duty)
+            {
+                pwm_pos_set[index] = duty;
+                changed = true;
+            }
+        }
+        if(changed) buildHeaterPWMEdges(pwm_pos_set);
+
+        for(uint8_t i = 0; i < heaterPWMOnEdgeCount; i++)
+        {
+#if HEATER_PINS_INVERTED
+            *heaterPWMOnEdges[i].port &= ~heaterPWMOnEdges[i].mask;
+#else
+            *heaterPWMOnEdges[i].port |= heaterPWMOnEdges[i].mask;
+#endif // HEATER_PINS_INVERTED
+        }
+        heaterPWMNextOffEdge = 0;
+    }
+
+    while(heaterPWMNextOffEdge < heaterPWMOffEdgeCount && heaterPWMOffEdges[heaterPWMNextOffEdge].count == pwm_count_heater)
+    {
+#if HEATER_PINS_INVERTED
+        *heaterPWMOffEdges[heaterPWMNextOffEdge].port |= heaterPWMOffEdges[heaterPWMNextOffEdge].mask;
+#else
+        *heaterPWMOffEdges[heaterPWMNextOffEdge].port &= ~heaterPWMOffEdges[heaterPWMNextOffEdge].mask;
+#endif // HEATER_PINS_INVERTED
+        heaterPWMNextOffEdge ++;
+    }
+#else
     if(pwm_count_heater == 0)
     {
 #if EXT0_HEATER_PIN>-1
@@ -961,6 +1134,7 @@ ISR(PWM_TIMER_VECTOR)
         if((pwm_pos_set[NUM_EXTRUDER] = (pwm_pos[NUM_EXTRUDER] & HEATER_PWM_MASK)) > 0) WRITE(HEATED_BED_HEATER_PIN, !HEATER_PINS_INVERTED);
 #endif // HEATED_BED_HEATER_PIN>-1 && HAVE_HEATED_BED
     }
+#endif // FEATURE_PWM_PORT_TABLE
 
     if(pwm_count_cooler == 0)
     {
@@ -1003,42 +1177,54 @@ ISR(PWM_TIMER_VECTOR)
     }
 
 #if EXT0_HEATER_PIN>-1
+#if !FEATURE_PWM_PORT_TABLE
     if(pwm_pos_set[0] == pwm_count_heater && pwm_pos_set[0]!=HEATER_PWM_MASK) WRITE(EXT0_HEATER_PIN,HEATER_PINS_INVERTED);
+#endif // !FEATURE_PWM_PORT_TABLE
 #if EXT0_EXTRUDER_COOLER_PIN>-1
     if(pwm_cooler_pos_set[0] == pwm_count_cooler && pwm_cooler_pos_set[0]!=255) WRITE(EXT0_EXTRUDER_COOLER_PIN,0);
 #endif // #if EXT0_EXTRUDER_COOLER_PIN>-1
 #endif // #if EXT0_HEATER_PIN>-1
 
 #if defined(EXT1_HEATER_PIN) && EXT1_HEATER_PIN>-1 && NUM_EXTRUDER>1
+#if !FEATURE_PWM_PORT_TABLE
     if(pwm_pos_set[1] == pwm_count_heater && pwm_pos_set[1]!=HEATER_PWM_MASK) WRITE(EXT1_HEATER_PIN,HEATER_PINS_INVERTED);
+#endif // !FEATURE_PWM_PORT_TABLE
 #if EXT1_EXTRUDER_COOLER_PIN>-1 && EXT1_EXTRUDER_COOLER_PIN!=EXT0_EXTRUDER_COOLER_PIN
     if(pwm_cooler_pos_set[1] == pwm_count_cooler && pwm_cooler_pos_set[1]!=255) WRITE(EXT1_EXTRUDER_COOLER_PIN,0);
 #endif // EXT1_EXTRUDER_COOLER_PIN>-1 && EXT1_EXTRUDER_COOLER_PIN!=EXT0_EXTRUDER_COOLER_PIN
 #endif // defined(EXT1_HEATER_PIN) && EXT1_HEATER_PIN>-1 && NUM_EXTRUDER>1
 
 #if defined(EXT2_HEATER_PIN) && EXT2_HEATER_PIN>-1 && NUM_EXTRUDER>2
+#if !FEATURE_PWM_PORT_TABLE
     if(pwm_pos_set[2] == pwm_count_heater && pwm_pos_set[2]!=HEATER_PWM_MASK) WRITE(EXT2_HEATER_PIN,HEATER_PINS_INVERTED);
+#endif // !FEATURE_PWM_PORT_TABLE
 #if EXT2_EXTRUDER_COOLER_PIN>-1
     if(pwm_cooler_pos_set[2] == pwm_count_cooler && pwm_cooler_pos_set[2]!=255) WRITE(EXT2_EXTRUDER_COOLER_PIN,0);
 #endif // EXT2_EXTRUDER_COOLER_PIN>-1
 #endif // defined(EXT2_HEATER_PIN) && EXT2_HEATER_PIN>-1 && NUM_EXTRUDER>2
 
 #if defined(EXT3_HEATER_PIN) && EXT3_HEATER_PIN>-1 && NUM_EXTRUDER>3
+#if !FEATURE_PWM_PORT_TABLE
     if(pwm_pos_set[3] == pwm_count_heater && pwm_pos_set[3]!=HEATER_PWM_MASK) WRITE(EXT3_HEATER_PIN,HEATER_PINS_INVERTED);
+#endif // !FEATURE_PWM_PORT_TABLE
 #if EXT3_EXTRUDER_COOLER_PIN>-1
     if(pwm_cooler_pos_set[3] == pwm_count_cooler && pwm_cooler_pos_set[3]!=255) WRITE(EXT3_EXTRUDER_COOLER_PIN,0);
 #endif // EXT3_EXTRUDER_COOLER_PIN>-1
 #endif // defined(EXT3_HEATER_PIN) && EXT3_HEATER_PIN>-1 && NUM_EXTRUDER>3
 
 #if defined(EXT4_HEATER_PIN) && EXT4_HEATER_PIN>-1 && NUM_EXTRUDER>4
+#if !FEATURE_PWM_PORT_TABLE
     if(pwm_pos_set[4] == pwm_count_heater && pwm_pos_set[4]!=HEATER_PWM_MASK) WRITE(EXT4_HEATER_PIN,HEATER_PINS_INVERTED);
+#endif // !FEATURE_PWM_PORT_TABLE
 #if EXT4_EXTRUDER_COOLER_PIN>-1
     if(pwm_cooler_pos_set[4] == pwm_count_cooler && pwm_cooler_pos_set[4]!=255) WRITE(EXT4_EXTRUDER_COOLER_PIN,0);
 #endif // EXT4_EXTRUDER_COOLER_PIN>-1
 #endif // defined(EXT4_HEATER_PIN) && EXT4_HEATER_PIN>-1 && NUM_EXTRUDER>4
 
 #if defined(EXT5_HEATER_PIN) && EXT5_HEATER_PIN>-1 && NUM_EXTRUDER>5
+#if !FEATURE_PWM_PORT_TABLE
     if(pwm_pos_set[5] == pwm_count_heater && pwm_pos_set[5]!=HEATER_PWM_MASK) WRITE(EXT5_HEATER_PIN,HEATER_PINS_INVERTED);
+#endif // !FEATURE_PWM_PORT_TABLE
 #if EXT5_EXTRUDER_COOLER_PIN>-1
     if(pwm_cooler_pos_set[5] == pwm_count_cooler && pwm_cooler_pos_set[5]!=255) WRITE(EXT5_EXTRUDER_COOLER_PIN,0);
 #endif // EXT5_EXTRUDER_COOLER_PIN>-1
@@ -1065,7 +1251,9 @@ ISR(PWM_TIMER_VECTOR)
 #endif // FAN_PIN>-1 && FEATURE_FAN_CONTROL
 
 #if HEATED_BED_HEATER_PIN>-1 && HAVE_HEATED_BED
+#if !FEATURE_PWM_PORT_TABLE
     if(pwm_pos_set[NUM_EXTRUDER] == pwm_count_heater && pwm_pos_set[NUM_EXTRUDER] != HEATER_PWM_MASK) WRITE(HEATED_BED_HEATER_PIN,HEATER_PINS_INVERTED);
+#endif // !FEATURE_PWM_PORT_TABLE
 #endif // HEATED_BED_HEATER_PIN>-1 && HAVE_HEATED_BED
 
     static int counter100Periodical = 0; // Approximate a 100ms timer :: blocks pingwatchdog s commandloop if not working
@@ -1102,7 +1290,7 @@ ISR(PWM_TIMER_VECTOR)
     }
 
     // read analog values
-#if ANALOG_INPUTS>0
+#if ANALOG_INPUTS>0 && !FEATURE_ADC_INTERRUPT
     if((ADCSRA & _BV(ADSC))==0)   // Conversion finished?
     {
         osAnalogInputBuildup[osAnalogInputPos] += ADCW;
@@ -1143,7 +1331,7 @@ ISR(PWM_TIMER_VECTOR)
         }
         ADCSRA |= _BV(ADSC);  // start next conversion
     }
-#endif // ANALOG_INPUTS>0
+#endif // ANALOG_INPUTS>0 && !FEATURE_ADC_INTERRUPT
 
     UI_FAST; // Short timed user interface action
 
@@ -1179,6 +1367,70 @@ void HAL::resetExtruderDirection()
 {
     extruderLastDirection = 0;
 }
+#if ANALOG_INPUTS>0 && FEATURE_ADC_INTERRUPT
+/**
+This interrupt is called whenever an analog conversion has been completed. The analog inputs are sampled in the order of osAnalogInputSchedule.
+Each input is sampled 2^ANALOG_INPUT_SAMPLE times, the decimated value is filtered and the next input is selected afterwards.
+The interrupt enables the interrupts again as its first instruction, so the stepper interrupt is delayed only by its entry and not by
+the filter. It can not interrupt itself, because the next conversion is started at its end.
+*/
+ISR(ADC_vect, ISR_NOBLOCK)
+{
+    uint8_t input = osAnalogInputPos;
+
+
+    osAnalogInputBuildup[input] += ADCW;
+    if(++osAnalogInputCounter[input]>=_BV(ANALOG_INPUT_SAMPLE))
+    {
+#if ANALOG_INPUT_BITS+ANALOG_INPUT_SAMPLE<12
+        uint value = osAnalogInputBuildup[input] << (12-ANALOG_INPUT_BITS-ANALOG_INPUT_SAMPLE);
+#endif // ANALOG_INPUT_BITS+ANALOG_INPUT_SAMPLE<12
+
+#if ANALOG_INPUT_BITS+ANALOG_INPUT_SAMPLE>12
+        uint value = osAnalogInputBuildup[input] >> (ANALOG_INPUT_BITS+ANALOG_INPUT_SAMPLE-12);
+#endif // ANALOG_INPUT_BITS+ANALOG_INPUT_SAMPLE>12
+
+#if ANALOG_INPUT_BITS+ANALOG_INPUT_SAMPLE==12
+        uint value = osAnalogInputBuildup[input];
+#endif // ANALOG_INPUT_BITS+ANALOG_INPUT_SAMPLE==12
+
+        // first order IIR filter: filtered = filtered - filtered/2^n + value, the result is filtered/2^n
+        uint filtered = osAnalogInputFiltered[input];
+        if(filtered)
+            filtered = filtered - (filtered >> ANALOG_INPUT_FILTER_SHIFT) + value;
+        else
+            filtered = value << ANALOG_INPUT_FILTER_SHIFT; // the first value initializes the filter
+        osAnalogInputFiltered[input] = filtered;
+        osAnalogInputValues[input] = filtered >> ANALOG_INPUT_FILTER_SHIFT;
+        osAnalogInputUpdates[input]++;
+
+        osAnalogInputBuildup[input] = 0;
+        osAnalogInputCounter[input] = 0;
+
+        // select the next input of the schedule
+        uint8_t slot = osAnalogInputSlot + 1;
+        if(slot >= osAnalogInputSlots) slot = 0;
+        osAnalogInputSlot = slot;
+        input = osAnalogInputSchedule[slot];
+        osAnalogInputPos = input;
+
+        uint8_t channel = pgm_read_byte(&osAnalogInputChannels[input]);
+
+#if defined(ADCSRB) && defined(MUX5)
+        if(channel & 8)  // Reading channel 0-7 or 8-15?
+            ADCSRB |= _BV(MUX5);
+        else
+            ADCSRB &= ~_BV(MUX5);
+#endif // #if defined(ADCSRB) && defined(MUX5)
+
+        ADMUX = (ADMUX & ~(0x1F)) | (channel & 7);
+    }
+    ADCSRA |= _BV(ADSC);  // start next conversion
+
+} // ISR(ADC_vect)
+#endif // ANALOG_INPUTS>0 && FEATURE_ADC_INTERRUPT
+
+
 /** \brief Timer routine for extruder stepper.
 Several methods need to move the extruder. To get a optima result,
 all methods update the printer_state.extruderStepsNeeded with the
@@ -1435,16 +1687,37 @@ RFHardwareSerial::RFHardwareSerial(ring_buffer_rx *rx_buffer, ring_buffer_tx *tx
     _udrie = udrie;
     _u2x = u2x;
 
+#if FEATURE_SERIAL_NON_BLOCKING
+    blockedCount    = 0;
+    blockedMicros   = 0;
+    nonBlocking     = SERIAL_NON_BLOCKING_DEFAULT;
+    dropOutput      = false;
+    droppedMessages = 0;
+#endif // FEATURE_SERIAL_NON_BLOCKING
+
 } // RFHardwareSerial
 
 
 // Public Methods //////////////////////////////////////////////////////////////
 
 
-void RFHardwareSerial::begin(unsigned long baud)
+/** \brief Computes the UBRR value for the given baudrate. The U2X mode and the normal mode are compared and the divisor with the smaller deviation from the requested baudrate is chosen, e.g. 250000, 500000 and 1000000 baud are exact at 16 MHz. */
+uint16_t RFHardwareSerial::computeBaudSetting(unsigned long baud, bool *useU2X)
 {
-    uint16_t    baud_setting;
-    bool        use_u2x = true;
+    uint16_t        settingU2X;
+    uint16_t        settingNormal;
+    unsigned long   errorU2X;
+    unsigned long   errorNormal;
+
+
+    // U2X: baud = F_CPU / 8 / (UBRR + 1), normal: baud = F_CPU / 16 / (UBRR + 1) - the divisors are rounded to the nearest value
+    settingU2X    = (F_CPU / 4 / baud + 1) / 2;
+    settingNormal = (F_CPU / 8 / baud + 1) / 2;
+    if (settingU2X)     settingU2X --;
+    if (settingNormal)  settingNormal --;
+
+    errorU2X    = labs((long)(F_CPU / 8 / (settingU2X + 1)) - (long)baud);
+    errorNormal = labs((long)(F_CPU / 16 / (settingNormal + 1)) - (long)baud);
 
 #if F_CPU == 16000000UL
     // hardcoded exception for compatibility with the bootloader shipped
@@ -1452,28 +1725,42 @@ void RFHardwareSerial::begin(unsigned long baud)
     // on the Uno and Mega 2560.
     if (baud == 57600)
     {
-        use_u2x = false;
+        errorU2X = 0xFFFFFFFF;
     }
 #endif // F_CPU == 16000000UL
 
-try_again:
-
-    if (use_u2x)
-    {
-        *_ucsra = 1 << _u2x;
-        baud_setting = (F_CPU / 4 / baud - 1) / 2;
-    }
-    else
+    if (settingU2X <= 4095 && errorU2X <= errorNormal)
     {
-        *_ucsra = 0;
-        baud_setting = (F_CPU / 8 / baud - 1) / 2;
+        *useU2X = true;
+        return settingU2X;
     }
 
-    if ((baud_setting > 4095) && use_u2x)
-    {
-        use_u2x = false;
-        goto try_again;
-    }
+    *useU2X = false;
+    return settingNormal;
+
+} // computeBaudSetting
+
+
+/** \brief Returns the baudrate which is really reached for the given baudrate. */
+unsigned long RFHardwareSerial::realBaudrate(unsigned long baud)
+{
+    bool        useU2X;
+    uint16_t    setting = computeBaudSetting(baud, &useU2X);
+
+
+    return (useU2X ? F_CPU / 8 : F_CPU / 16) / ((unsigned long)setting + 1);
+
+} // realBaudrate
+
+
+void RFHardwareSerial::begin(unsigned long baud)
+{
+    uint16_t    baud_setting;
+    bool        use_u2x;
+
+
+    baud_setting = computeBaudSetting(baud, &use_u2x);
+    *_ucsra = use_u2x ? 1 << _u2x : 0;
 
     // assign the baud_setting, a.k.a. ubbr (USART Baud Rate Register)
     *_ubrrh = baud_setting >> 8;
@@ -1553,9 +1840,30 @@ size_t RFHardwareSerial::write(uint8_t c)
     uint8_t i = (_tx_buffer->head + 1) & SERIAL_TX_BUFFER_MASK;
 
 
+#if FEATURE_SERIAL_NON_BLOCKING
+    if (dropOutput)
+    {
+        // the current low priority output is dropped completely
+        return 1;
+    }
+#endif // FEATURE_SERIAL_NON_BLOCKING
+
     // If the output buffer is full, there's nothing for it other than to
     // wait for the interrupt handler to empty it a bit
+#if FEATURE_SERIAL_NON_BLOCKING
+    if (i == _tx_buffer->tail)
+    {
+        unsigned long   startTime = HAL::timeInMicroseconds();
+
+
+        while (i == _tx_buffer->tail);
+
+        blockedMicros += HAL::timeInMicroseconds() - startTime;
+        blockedCount ++;
+    }
+#else
     while (i == _tx_buffer->tail);
+#endif // FEATURE_SERIAL_NON_BLOCKING
 
     _tx_buffer->buffer[_tx_buffer->head] = c;
     _tx_buffer->head = i;
@@ -1566,6 +1874,29 @@ size_t RFHardwareSerial::write(uint8_t c)
 } // write
 
 
+#if FEATURE_SERIAL_NON_BLOCKING
+/** \brief Starts a low priority output. In case the output buffer is almost full, the complete output until endLowPriority() is dropped instead of waiting for free space. Returns false if the output is dropped. */
+bool RFHardwareSerial::beginLowPriority(void)
+{
+    if (nonBlocking && outputUnused() < SERIAL_LOW_PRIORITY_RESERVE)
+    {
+        dropOutput = true;
+        droppedMessages ++;
+        return false;
+    }
+    return true;
+
+} // beginLowPriority
+
+
+void RFHardwareSerial::endLowPriority(void)
+{
+    dropOutput = false;
+
+} // endLowPriority
+#endif // FEATURE_SERIAL_NON_BLOCKING
+
+
 // Preinstantiate Objects //////////////////////////////////////////////////////
 
 
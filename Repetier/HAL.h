@@ -190,11 +190,20 @@ void FEATURE_READ_CALIPER_HOOK(); //read in calipers 48bit protocol bitwise!
 */
 
 #undef SERIAL_RX_BUFFER_SIZE
+#undef SERIAL_TX_BUFFER_SIZE
 //undef fix gegen compiler warning   
 #define SERIAL_RX_BUFFER_SIZE   128
 #define SERIAL_RX_BUFFER_MASK   127
-#define SERIAL_TX_BUFFER_SIZE    64
-#define SERIAL_TX_BUFFER_MASK    63
+#define SERIAL_TX_BUFFER_SIZE   SERIAL_OUTPUT_BUFFER_SIZE
+#define SERIAL_TX_BUFFER_MASK   (SERIAL_OUTPUT_BUFFER_SIZE-1)
+
+#if SERIAL_TX_BUFFER_SIZE > 256 || (SERIAL_TX_BUFFER_SIZE & SERIAL_TX_BUFFER_MASK) != 0
+    #error SERIAL_OUTPUT_BUFFER_SIZE must be a power of 2 and not larger than 256.
+#endif // SERIAL_TX_BUFFER_SIZE > 256 || (SERIAL_TX_BUFFER_SIZE & SERIAL_TX_BUFFER_MASK) != 0
+
+#if FEATURE_SERIAL_NON_BLOCKING && SERIAL_LOW_PRIORITY_RESERVE >= SERIAL_TX_BUFFER_SIZE
+    #error SERIAL_LOW_PRIORITY_RESERVE must be smaller than SERIAL_OUTPUT_BUFFER_SIZE.
+#endif // FEATURE_SERIAL_NON_BLOCKING && SERIAL_LOW_PRIORITY_RESERVE >= SERIAL_TX_BUFFER_SIZE
 
 struct ring_buffer_rx
 {
@@ -225,6 +234,16 @@ public:
     uint8_t             _rxcie;
     uint8_t             _udrie;
     uint8_t             _u2x;
+
+#if FEATURE_SERIAL_NON_BLOCKING
+    // statistics about the waiting for free space within the output buffer
+    uint32_t            blockedCount;
+    uint32_t            blockedMicros;
+
+    bool                nonBlocking;
+    bool                dropOutput;
+    uint32_t            droppedMessages;
+#endif // FEATURE_SERIAL_NON_BLOCKING
 public:
     RFHardwareSerial(ring_buffer_rx *rx_buffer, ring_buffer_tx *tx_buffer,
                      volatile uint8_t *ubrrh, volatile uint8_t *ubrrl,
@@ -233,6 +252,8 @@ public:
                      uint8_t rxen, uint8_t txen, uint8_t rxcie, uint8_t udrie, uint8_t u2x);
     void begin(unsigned long);
     void end();
+    static uint16_t computeBaudSetting(unsigned long baud, bool *useU2X);
+    static unsigned long realBaudrate(unsigned long baud);
     virtual int available(void);
     virtual int peek(void);
     virtual int read(void);
@@ -241,6 +262,11 @@ public:
     using Print::write; // pull in write(str) and write(buf, size) from Print
     operator bool();
     int outputUnused(void); // Used for output in interrupts
+
+#if FEATURE_SERIAL_NON_BLOCKING
+    bool beginLowPriority(void);
+    void endLowPriority(void);
+#endif // FEATURE_SERIAL_NON_BLOCKING
 };
 
 extern RFHardwareSerial RFSerial;
@@ -655,6 +655,102 @@ uint8_t Printer::setDestinationStepsFromGCode(GCode *com)
 } // setDestinationStepsFromGCode
 
 
+#if FEATURE_FAST_MOVES
+/**
+  \brief Sets the destination coordinates of a plain G0/G1 (see GCode::isPlainMove()) in absolute mm coordinates.
+  Works like setDestinationStepsFromGCode() and computes the targets with the same expressions, but without the unit and relative mode handling.
+  The axes which are not given are not converted at all.
+*/
+uint8_t Printer::setDestinationStepsFromPlainMove(GCode *com)
+{
+    long    p;
+    float   x, y, z;
+
+
+    if(com->hasX()) queuePositionCommandMM[X_AXIS] = queuePositionLastMM[X_AXIS] = com->X - originOffsetMM[X_AXIS];
+    if(com->hasY()) queuePositionCommandMM[Y_AXIS] = queuePositionLastMM[Y_AXIS] = com->Y - originOffsetMM[Y_AXIS];
+    if(com->hasZ()) queuePositionCommandMM[Z_AXIS] = queuePositionLastMM[Z_AXIS] = com->Z - originOffsetMM[Z_AXIS];
+
+    x = queuePositionCommandMM[X_AXIS] + Printer::extruderOffset[X_AXIS];
+    y = queuePositionCommandMM[Y_AXIS] + Printer::extruderOffset[Y_AXIS];
+    z = queuePositionCommandMM[Z_AXIS] + Printer::extruderOffset[Z_AXIS];
+
+    if(com->hasX())
+    {
+        queuePositionTargetSteps[X_AXIS] = static_cast<long>(floor(x * axisStepsPerMM[X_AXIS] + 0.5f));
+    }
+    else
+    {
+        queuePositionTargetSteps[X_AXIS] = queuePositionLastSteps[X_AXIS];
+    }
+
+    if(com->hasY())
+    {
+        queuePositionTargetSteps[Y_AXIS] = static_cast<long>(floor(y * axisStepsPerMM[Y_AXIS] + 0.5f));
+    }
+    else
+    {
+        queuePositionTargetSteps[Y_AXIS] = queuePositionLastSteps[Y_AXIS];
+    }
+
+    if(com->hasZ())
+    {
+        queuePositionTargetSteps[Z_AXIS] = static_cast<long>(floor(z * axisStepsPerMM[Z_AXIS] + 0.5f));
+    }
+    else
+    {
+        queuePositionTargetSteps[Z_AXIS] = queuePositionLastSteps[Z_AXIS];
+    }
+
+    if(com->hasE())
+    {
+        p = com->E * axisStepsPerMM[E_AXIS];
+        if(relativeExtruderCoordinateMode)
+        {
+            if(
+#if MIN_EXTRUDER_TEMP > 30
+                Extruder::current->tempControl.currentTemperatureC < MIN_EXTRUDER_TEMP ||
+#endif // MIN_EXTRUDER_TEMP > 30
+                fabs(com->E) * extrusionFactor > EXTRUDE_MAXLENGTH)
+            {
+                p = 0;
+            }
+            queuePositionTargetSteps[E_AXIS] = queuePositionLastSteps[E_AXIS] + p;
+        }
+        else
+        {
+            if(
+#if MIN_EXTRUDER_TEMP > 30
+                Extruder::current->tempControl.currentTemperatureC < MIN_EXTRUDER_TEMP ||
+#endif // MIN_EXTRUDER_TEMP > 30
+                fabs(p - queuePositionLastSteps[E_AXIS]) * extrusionFactor > EXTRUDE_MAXLENGTH * axisStepsPerMM[E_AXIS])
+            {
+                queuePositionLastSteps[E_AXIS] = p;
+            }
+            queuePositionTargetSteps[E_AXIS] = p;
+        }
+    }
+    else
+    {
+        queuePositionTargetSteps[E_AXIS] = queuePositionLastSteps[E_AXIS];
+    }
+
+    if(com->hasF())
+    {
+        feedrate = com->F * (float)feedrateMultiply * 0.00016666666f;
+    }
+
+    if(!isPositionAllowed(x,y,z))
+    {
+        queuePositionLastSteps[E_AXIS] = queuePositionTargetSteps[E_AXIS];
+        return false; // ignore move
+    }
+    return !com->hasNoXYZ() || (com->hasE() && queuePositionTargetSteps[E_AXIS] != queuePositionLastSteps[E_AXIS]); // ignore unproductive moves
+
+} // setDestinationStepsFromPlainMove
+#endif // FEATURE_FAST_MOVES
+
+
 /**
   \brief Sets the destination coordinates to the passed values.
 */
@@ -1325,6 +1421,22 @@ void Printer::defaultLoopActions()
     sd.automount();
 #endif // defined(SDCARDDETECT) && SDCARDDETECT>-1 && defined(SDSUPPORT) && SDSUPPORT
 
+#if SDSUPPORT && FEATURE_SD_NONBLOCKING_MOUNT
+    sd.mountStep();
+#endif // SDSUPPORT && FEATURE_SD_NONBLOCKING_MOUNT
+
+#if SDSUPPORT && FEATURE_SD_BINARY_CACHE
+    sd.convertStep();
+#endif // SDSUPPORT && FEATURE_SD_BINARY_CACHE
+
+#if SDSUPPORT && FEATURE_SD_PREFLIGHT_SCAN
+    sd.preflightStep();
+#endif // SDSUPPORT && FEATURE_SD_PREFLIGHT_SCAN
+
+#if SDSUPPORT && FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
+    sd.toolChangeScanStep();
+#endif // SDSUPPORT && FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
+
     DEBUG_MEMORY;
 
 } // defaultLoopActions
@@ -682,6 +682,7 @@ public:
         setAnimation(!isAnimation());
     } // toggleAnimation
 
+
     static INLINE float convertToMM(float x)
     {
         return (unitIsInches ? x*25.4 : x);
@@ -1213,6 +1214,9 @@ public:
     static void setup();
     static void defaultLoopActions();
     static uint8_t setDestinationStepsFromGCode(GCode *com);
+#if FEATURE_FAST_MOVES
+    static uint8_t setDestinationStepsFromPlainMove(GCode *com);
+#endif // FEATURE_FAST_MOVES
     static uint8_t setDestinationStepsFromMenu( float relativeX, float relativeY, float relativeZ );
     static void moveTo(float x,float y,float z,float e,float f);
     static void moveToReal(float x,float y,float z,float e,float f);
@@ -65,6 +65,19 @@ FSTRINGVALUE( ui_text_saving_success, UI_TEXT_SAVING_SUCCESS )
 
 unsigned long   g_uStartOfIdle             = 0;
 
+#if FEATURE_BAUDRATE_SWITCHING && !defined(EXTERNALSERIAL)
+long            g_nCurrentBaudrate         = 0;
+long            g_nPreviousBaudrate        = 0;
+unsigned long   g_uBaudrateSwitchTime      = 0;
+uint32_t        g_nBaudrateSwitchErrors    = 0;
+uint32_t        g_nBaudrateSwitchCommands  = 0;
+char            g_nBaudrateProbation       = 0;
+#endif // FEATURE_BAUDRATE_SWITCHING && !defined(EXTERNALSERIAL)
+
+#if ANALOG_INPUTS>0 && FEATURE_ADC_INTERRUPT
+unsigned long   g_uAnalogInputStatisticsTime = 0;
+#endif // ANALOG_INPUTS>0 && FEATURE_ADC_INTERRUPT
+
 #if FEATURE_HEAT_BED_Z_COMPENSATION
 long            g_offsetZCompensationSteps = 0;
 long            g_minZCompensationSteps    = HEAT_BED_Z_COMPENSATION_MIN_STEPS;
@@ -6158,6 +6171,13 @@ void loopRF( void ) //wird so aufgerufen, dass es ein ~100ms takt sein sollte.
         Printer::setPrinting(true);
     }
 
+#if FEATURE_BAUDRATE_SWITCHING && !defined(EXTERNALSERIAL)
+    if( g_nBaudrateProbation )
+    {
+        checkBaudrateSwitch();
+    }
+#endif // FEATURE_BAUDRATE_SWITCHING && !defined(EXTERNALSERIAL)
+
 #if FEATURE_CASE_FAN && !CASE_FAN_ALWAYS_ON
     if( Printer::prepareFanOff )
     {
@@ -6675,6 +6695,124 @@ void loopRF( void ) //wird so aufgerufen, dass es ein ~100ms takt sein sollte.
 
 } // loopRF
 
+
+#if FEATURE_BAUDRATE_SWITCHING && !defined(EXTERNALSERIAL)
+void applyBaudrate( long newBaudrate )
+{
+    // the pending output (including the "ok" of the current command) must be sent with the old baudrate
+    HAL::serialFlush();
+    HAL::delayMilliseconds( 2 );
+
+    HAL::serialSetBaudrate( newBaudrate );
+    g_nCurrentBaudrate = newBaudrate;
+    return;
+
+} // applyBaudrate
+
+
+void startBaudrateSwitch( long newBaudrate )
+{
+    long    nDeviation;
+
+
+    if( !g_nCurrentBaudrate )
+    {
+        g_nCurrentBaudrate = baudrate;
+    }
+
+    if( g_nBaudrateProbation )
+    {
+        if( Printer::debugErrors() )
+        {
+            Com::printFLN( PSTR( "M3411: the previous switch of the baudrate has not been confirmed yet" ) );
+        }
+        return;
+    }
+
+    if( newBaudrate <= 0 )
+    {
+        showInvalidSyntax( 3411 );
+        return;
+    }
+
+    nDeviation = labs( (long)RFHardwareSerial::realBaudrate( newBaudrate ) - newBaudrate );
+    if( nDeviation > newBaudrate / 1000 * SERIAL_BAUDRATE_MAX_DEVIATION )
+    {
+        if( Printer::debugErrors() )
+        {
+            Com::printF( PSTR( "M3411: this baudrate can not be reached accurately enough: " ), newBaudrate );
+            Com::printFLN( PSTR( " [baud]" ) );
+        }
+        return;
+    }
+
+    if( Printer::debugInfo() )
+    {
+        Com::printF( PSTR( "M3411: switching to " ), newBaudrate );
+        Com::printFLN( PSTR( " [baud]" ) );
+    }
+
+    g_nPreviousBaudrate       = g_nCurrentBaudrate;
+    g_nBaudrateSwitchErrors   = GCode::serialChecksumErrors + GCode::serialResendRequests;
+    g_nBaudrateSwitchCommands = GCode::serialCommandsReceived;
+
+    applyBaudrate( newBaudrate );
+
+    g_uBaudrateSwitchTime = HAL::timeInMilliseconds();
+    g_nBaudrateProbation  = 1;
+    return;
+
+} // startBaudrateSwitch
+
+
+void checkBaudrateSwitch( void )
+{
+    uint32_t    nErrors = GCode::serialChecksumErrors + GCode::serialResendRequests - g_nBaudrateSwitchErrors;
+    char        bFallback;
+
+
+    if( nErrors > SERIAL_BAUDRATE_FALLBACK_ERRORS )
+    {
+        // the connection is not reliable with the new baudrate
+        bFallback = 1;
+    }
+    else if( (HAL::timeInMilliseconds() - g_uBaudrateSwitchTime) < SERIAL_BAUDRATE_PROBATION_TIME )
+    {
+        // the probation time is not over yet
+        return;
+    }
+    else
+    {
+        // the host must have sent at least one valid command with the new baudrate
+        bFallback = (GCode::serialCommandsReceived == g_nBaudrateSwitchCommands);
+    }
+
+    g_nBaudrateProbation = 0;
+
+    if( bFallback )
+    {
+        applyBaudrate( g_nPreviousBaudrate );
+
+        if( Printer::debugErrors() )
+        {
+            Com::printF( PSTR( "M3411: fallback to " ), g_nPreviousBaudrate );
+            Com::printF( PSTR( " [baud], errors: " ), nErrors );
+            Com::printFLN( PSTR( ", commands: " ), GCode::serialCommandsReceived - g_nBaudrateSwitchCommands );
+        }
+    }
+    else
+    {
+        if( Printer::debugInfo() )
+        {
+            Com::printF( PSTR( "M3411: confirmed " ), g_nCurrentBaudrate );
+            Com::printFLN( PSTR( " [baud], errors: " ), nErrors );
+        }
+    }
+    return;
+
+} // checkBaudrateSwitch
+#endif // FEATURE_BAUDRATE_SWITCHING && !defined(EXTERNALSERIAL)
+
 #if FEATURE_OUTPUT_FINISHED_OBJECT
 void outputObject( void )
 {
@@ -9598,6 +9736,208 @@ void processCommand( GCode* pCommand )
                 break;
             }
 
+#if SDSUPPORT && FEATURE_SD_BINARY_CACHE
+            case 3400: // M3400 [filename] - convert a G-Code file into its binary sibling file
+            {
+                if( pCommand->hasString() )
+                {
+                    sd.startConvert( pCommand->text );
+                }
+                else
+                {
+                    sd.printConvertStatus();
+                }
+                break;
+            }
+
+            case 3401: // M3401 - abort the conversion of a G-Code file into its binary sibling file
+            {
+                sd.abortConvert();
+                break;
+            }
+#endif // SDSUPPORT && FEATURE_SD_BINARY_CACHE
+
+#ifndef EXTERNALSERIAL
+#if FEATURE_SERIAL_NON_BLOCKING
+            case 3410: // M3410 [S] [P] - configure the non-blocking serial output and output the serial output statistics
+            {
+                if( pCommand->hasS() )
+                {
+                    RFSERIAL.nonBlocking = (pCommand->S != 0);
+                }
+
+                if( Printer::debugInfo() )
+                {
+                    Com::printF( PSTR( "M3410: non-blocking: " ), (int)RFSERIAL.nonBlocking );
+                    Com::printF( PSTR( ", dropped: " ), RFSERIAL.droppedMessages );
+                    Com::printF( PSTR( ", waits: " ), RFSERIAL.blockedCount );
+                    Com::printF( PSTR( ", waiting time: " ), RFSERIAL.blockedMicros );
+                    Com::printFLN( PSTR( " [us]" ) );
+                }
+
+                if( pCommand->hasP() && pCommand->P == 1 )
+                {
+                    RFSERIAL.blockedCount    = 0;
+                    RFSERIAL.blockedMicros   = 0;
+                    RFSERIAL.droppedMessages = 0;
+                }
+                break;
+            }
+#endif // FEATURE_SERIAL_NON_BLOCKING
+
+#if FEATURE_BAUDRATE_SWITCHING
+            case 3411: // M3411 [S] - switch the baudrate with automatic fallback and output the link statistics
+            {
+                if( pCommand->hasS() )
+                {
+                    startBaudrateSwitch( pCommand->S );
+                }
+                else if( Printer::debugInfo() )
+                {
+                    Com::printF( PSTR( "M3411: baudrate: " ), g_nCurrentBaudrate ? g_nCurrentBaudrate : baudrate );
+                    Com::printF( PSTR( " (real: " ), (uint32_t)RFHardwareSerial::realBaudrate( g_nCurrentBaudrate ? g_nCurrentBaudrate : baudrate ) );
+                    Com::printF( PSTR( "), commands: " ), GCode::serialCommandsReceived );
+                    Com::printF( PSTR( ", checksum errors: " ), GCode::serialChecksumErrors );
+                    Com::printFLN( PSTR( ", resends: " ), GCode::serialResendRequests );
+                }
+                break;
+            }
+#endif // FEATURE_BAUDRATE_SWITCHING
+#endif // EXTERNALSERIAL
+
+#if ANALOG_INPUTS>0 && FEATURE_ADC_INTERRUPT
+            case 3412: // M3412 [P] - output the sample rates of the analog inputs
+            {
+                unsigned long   uNow     = HAL::timeInMilliseconds();
+                unsigned long   uElapsed = uNow - g_uAnalogInputStatisticsTime;
+                unsigned long   uTotal   = 0;
+                uint32_t        nUpdates;
+                uint            nRaw;
+
+
+                if( !uElapsed )
+                {
+                    uElapsed = 1;
+                }
+
+                for( uint8_t i=0; i<ANALOG_INPUTS; i++ )
+                {
+                    InterruptProtectedBlock noInts;
+                    nUpdates = osAnalogInputUpdates[i];
+                    nRaw     = osAnalogInputValues[i];
+                    if( pCommand->hasP() && pCommand->P == 1 )
+                    {
+                        osAnalogInputUpdates[i] = 0;
+                    }
+                    noInts.unprotect();
+
+                    uTotal += nUpdates;
+                    if( Printer::debugInfo() )
+                    {
+                        Com::printF( PSTR( "M3412: input " ), (int)i );
+                        Com::printF( PSTR( ", channel " ), (int)pgm_read_byte( &osAnalogInputChannels[i] ) );
+                        Com::printF( PSTR( ": " ), (float)nUpdates * 1000.0f / (float)uElapsed, 1 );
+                        Com::printF( PSTR( " [values/s], raw: " ), (int)nRaw );
+                        Com::printFLN( PSTR( ", values: " ), nUpdates );
+                    }
+                }
+
+                if( Printer::debugInfo() )
+                {
+                    Com::printF( PSTR( "M3412: conversions: " ), (float)uTotal * (float)_BV(ANALOG_INPUT_SAMPLE) * 1000.0f / (float)uElapsed, 0 );
+                    Com::printF( PSTR( " [1/s], time: " ), uElapsed );
+                    Com::printFLN( PSTR( " [ms]" ) );
+                }
+
+                if( pCommand->hasP() && pCommand->P == 1 )
+                {
+                    g_uAnalogInputStatisticsTime = uNow;
+                }
+                break;
+            }
+#endif // ANALOG_INPUTS>0 && FEATURE_ADC_INTERRUPT
+
+#if FEATURE_HEAT_MODEL_CONTROL
+            case 3413: // M3413 [P] [X] [Y] [Z] - configure/output the thermal model of a heater ( heat rate, loss rate, dead time )
+            {
+                uint8_t                 nController = 0;
+                TemperatureController*  pController;
+
+
+                if( pCommand->hasP() )
+                {
+                    if( pCommand->P < 0 || pCommand->P >= NUM_TEMPERATURE_LOOPS )
+                    {
+                        if( Printer::debugErrors() )
+                        {
+                            Com::printFLN( PSTR( "M3413: invalid controller (P)" ) );
+                        }
+                        break;
+                    }
+                    nController = (uint8_t)pCommand->P;
+                }
+
+                pController = tempController[nController];
+                if( pCommand->hasX() && pCommand->X > 0 )   pController->modelHeatRate = pCommand->X;
+                if( pCommand->hasY() && pCommand->Y >= 0 )  pController->modelLossRate = pCommand->Y;
+                if( pCommand->hasZ() && pCommand->Z >= 0 )  pController->modelDeadTime = pCommand->Z;
+                pController->updateTempControlVars();
+
+                if( Printer::debugInfo() )
+                {
+                    Com::printF( PSTR( "M3413: controller " ), (int)nController );
+                    Com::printF( PSTR( ", heat rate: " ), pController->modelHeatRate, 3 );
+                    Com::printF( PSTR( " [°C/s], loss rate: " ), pController->modelLossRate, 5 );
+                    Com::printF( PSTR( " [1/s], dead time: " ), pController->modelDeadTime, 1 );
+                    Com::printFLN( PSTR( " [s], heat manager: " ), (int)pController->heatManager );
+                }
+                break;
+            }
+#endif // FEATURE_HEAT_MODEL_CONTROL
+
+#if FEATURE_ADAPTIVE_TEMPERATURE_REPORT
+            case 3414: // M3414 [S] - configure/output the temperature report mode ( 0 = fixed interval, 1 = adaptive, 2 = binary temperature frames )
+            {
+                if( pCommand->hasS() )
+                {
+                    if( pCommand->S < TEMPERATURE_REPORT_FIXED || pCommand->S > TEMPERATURE_REPORT_BINARY )
+                    {
+                        if( Printer::debugErrors() )
+                        {
+                            Com::printFLN( PSTR( "M3414: invalid report mode (S)" ) );
+                        }
+                        break;
+                    }
+                    Commands::temperatureReportMode = (uint8_t)pCommand->S;
+                }
+
+                if( Printer::debugInfo() )
+                {
+                    Com::printFLN( PSTR( "M3414: temperature report mode: " ), (int)Commands::temperatureReportMode );
+                }
+                break;
+            }
+#endif // FEATURE_ADAPTIVE_TEMPERATURE_REPORT
+
+#if SDSUPPORT && FEATURE_SD_BLOCK_UPLOAD
+            case 3416: // M3416 [filename] - upload a file to the SD card as raw data blocks
+            {
+                if( pCommand->hasString() )
+                {
+                    sd.startBlockUpload( pCommand->text );
+                }
+                break;
+            }
+#endif // SDSUPPORT && FEATURE_SD_BLOCK_UPLOAD
+
+#if SDSUPPORT && FEATURE_SD_PREFLIGHT_SCAN
+            case 3417: // M3417 - output the result of the scan of the selected file ( CRC32, lines, range of the positions, extrusion )
+            {
+                sd.printPreflightStatus();
+                break;
+            }
+#endif // SDSUPPORT && FEATURE_SD_PREFLIGHT_SCAN
+
 #if FEATURE_24V_FET_OUTPUTS
             case 3300: // M3300 [P] [S] - configure the 24V FET outputs ( on/off )
             {
@@ -375,6 +375,68 @@
 
 - M3200 [P] [S] - reserved for test and debug
 
+- M3400 [filename] - convert an ASCII G-Code file into a binary sibling file ( e.g. "part.gcode" -> "part.bgc" ), comments and line numbers are stripped
+  - the conversion is performed in the background while nothing is printed/milled, the next selection of the source file uses the binary sibling file automatically as long as the source file has not been changed
+  - Examples:
+  - M3400 part.gcode ; starts the conversion of part.gcode
+  - M3400 ; outputs the progress of the current conversion
+
+- M3401 - abort the conversion of a G-Code file into a binary sibling file
+  - Examples:
+  - M3401 ; aborts the current conversion and removes the incomplete binary sibling file
+
+- M3410 [S] [P] - configure the non-blocking serial output and output the serial output statistics ( waits for free space within the output buffer, the time spent waiting, dropped low priority outputs )
+  - Examples:
+  - M3410 ; outputs the serial output statistics
+  - M3410 S1 ; periodic temperatures and echo outputs are dropped while the serial output buffer is almost full
+  - M3410 S0 ; all outputs wait for free space within the serial output buffer
+  - M3410 P1 ; outputs the serial output statistics and resets them afterwards
+
+- M3411 [S] - switch the baudrate ( units are [baud] ) or output the link statistics ( valid commands, checksum errors, resend requests )
+  - after the switch, the host must send at least one valid command with the new baudrate within 5 [s], otherwise the firmware falls back to the previous baudrate
+  - the firmware falls back to the previous baudrate also in case more than 10 checksum errors/resend requests occur within this time
+  - the host shall switch its baudrate after it has received the "M3411: switching to" message, the new baudrate is not stored to the EEPROM
+  - Examples:
+  - M3411 S250000 ; switches to 250000 [baud]
+  - M3411 S1000000 ; switches to 1000000 [baud]
+  - M3411 ; outputs the current baudrate and the link statistics
+
+- M3412 [P] - output the sample rates of the analog inputs ( filtered values per second of each input, ADC conversions per second )
+  - the statistics cover the time since the start of the firmware or since their last reset
+  - Examples:
+  - M3412 ; outputs the sample rates of the analog inputs
+  - M3412 P1 ; outputs the sample rates of the analog inputs and resets the statistics afterwards
+
+- M3413 [P] [X] [Y] [Z] - configure/output the thermal model of a heater, which is used by heat manager 4 ( P: 0 = extruder 0, 1 = extruder 1, ..., last = heat bed; X: heating rate at full power [°C/s]; Y: loss rate [1/s]; Z: dead time [s] )
+  - Examples:
+  - M3413 ; outputs the thermal model of the first extruder
+  - M3413 P0 X2.5 Y0.008 Z3 ; sets the thermal model of the first extruder
+
+- M3414 [S] - configure/output the temperature report mode ( S: 0 = temperature line once per second, 1 = temperature line only on changes, 2 = binary temperature frames only on changes )
+  - in the modes 1 and 2, the temperatures are reported as soon as a temperature or a heater output changes noticeably, but at least every TEMPERATURE_REPORT_MAX_INTERVAL
+  - a binary temperature frame consists of 0x02, 'T', the number of heaters n, n * ( current temperature [0.1 °C] and target temperature [°C] as little endian int16, output [0 ... 255] ) and the fletcher-16 checksum of all bytes after 0x02
+  - M105 answers with the temperature line in all modes
+  - Examples:
+  - M3414 ; outputs the current temperature report mode
+  - M3414 S2 ; switches to binary temperature frames
+
+- M3416 [filename] - upload a file to the SD card as raw data blocks instead of G-Code lines
+  - the firmware answers with "SD block upload: size <n>, window <w>" and "SD block ok: 0", afterwards all serial data belong to the upload
+  - a data block consists of 0x02, the sequence number and the payload length ( little endian uint16, at most <n> bytes ), the payload and the CRC-16/MCRF4XX of all bytes after 0x02 ( little endian )
+  - the host may send up to <w> blocks ahead of the last "SD block ok: <s>", which confirms all blocks before <s>
+  - "SD block resend: <s>" requests all blocks from <s> on again, a block with an empty payload ends the upload
+  - M112 which is sent between two blocks stops the upload and the printer, the upload ends as well after SD_BLOCK_UPLOAD_TIMEOUT without data
+  - Examples:
+  - M3416 part.gco ; starts the upload of part.gco
+
+- M3417 - output the result of the scan of the selected file
+  - the file which is selected via M23 is scanned while the printer is idle, the result is output at the end of the scan and shown on the display
+  - the result consists of the CRC-32 of the whole file, the number of commands, the total extrusion and the range of the X, Y and Z positions compared with the travel range of the machine
+  - arcs are followed to their end point only, a print from the SD card pauses the scan
+  - only the host can wait for the result before it starts the print (M24), a print which is started from the display is not checked
+  - Examples:
+  - M3417 ; outputs the progress or the result of the scan
+
 
 // ##########################################################################################
 // ##   the following M codes are supported only by the RF2000
@@ -863,6 +925,17 @@ extern void doZCompensation( void );
 // loopRF()
 extern void loopRF( void );
 
+#if FEATURE_BAUDRATE_SWITCHING && !defined(EXTERNALSERIAL)
+// applyBaudrate()
+extern void applyBaudrate( long newBaudrate );
+
+// startBaudrateSwitch()
+extern void startBaudrateSwitch( long newBaudrate );
+
+// checkBaudrateSwitch()
+extern void checkBaudrateSwitch( void );
+#endif // FEATURE_BAUDRATE_SWITCHING && !defined(EXTERNALSERIAL)
+
 #if FEATURE_OUTPUT_FINISHED_OBJECT
 // outputObject()
 extern void outputObject( void );
@@ -235,9 +235,9 @@ NTC-Thermistors
 12: 100k RS Thermistor 198-961 (4.7k pullup)
 14: Thermistor NTC 3950 100k Ohm (Version 1)
 15: Thermistor NTC 3950 100k Ohm (Version 2)
-97: USE_GENERIC_THERMISTORTABLE_1 and GENERIC_THERM_NUM_ENTRIES Define Raw Thermistor and Resistor-Settings within configuration.h
-98: USE_GENERIC_THERMISTORTABLE_2 and GENERIC_THERM_NUM_ENTRIES Define Raw Thermistor and Resistor-Settings within configuration.h
-99: USE_GENERIC_THERMISTORTABLE_3 and GENERIC_THERM_NUM_ENTRIES Define Raw Thermistor and Resistor-Settings within configuration.h
+97: USE_GENERIC_THERMISTORTABLE_1 Define Raw Thermistor and Resistor-Settings within configuration.h
+98: USE_GENERIC_THERMISTORTABLE_2 Define Raw Thermistor and Resistor-Settings within configuration.h
+99: USE_GENERIC_THERMISTORTABLE_3 Define Raw Thermistor and Resistor-Settings within configuration.h
 PTC-Thermistors
 13: E3D PT100 (externe Platine, 500°C)
 50: USER_THERMISTORTABLE0 als PTC
@@ -398,9 +398,9 @@ NTC-Thermistors
 12: 100k RS Thermistor 198-961 (4.7k pullup)
 14: Thermistor NTC 3950 100k Ohm (Version 1)
 15: Thermistor NTC 3950 100k Ohm (Version 2)
-97: USE_GENERIC_THERMISTORTABLE_1 and GENERIC_THERM_NUM_ENTRIES Define Raw Thermistor and Resistor-Settings within configuration.h
-98: USE_GENERIC_THERMISTORTABLE_2 and GENERIC_THERM_NUM_ENTRIES Define Raw Thermistor and Resistor-Settings within configuration.h
-99: USE_GENERIC_THERMISTORTABLE_3 and GENERIC_THERM_NUM_ENTRIES Define Raw Thermistor and Resistor-Settings within configuration.h
+97: USE_GENERIC_THERMISTORTABLE_1 Define Raw Thermistor and Resistor-Settings within configuration.h
+98: USE_GENERIC_THERMISTORTABLE_2 Define Raw Thermistor and Resistor-Settings within configuration.h
+99: USE_GENERIC_THERMISTORTABLE_3 Define Raw Thermistor and Resistor-Settings within configuration.h
 PTC-Thermistors
 13: E3D PT100 (externe Platine, 500°C)
 50: USER_THERMISTORTABLE0 als PTC
@@ -124,6 +124,17 @@ extern volatile uint8   osAnalogInputCounter[ANALOG_INPUTS];
 extern volatile uint    osAnalogInputBuildup[ANALOG_INPUTS];
 extern volatile uint8   osAnalogInputPos; // Current sampling position
 extern volatile uint    osAnalogInputValues[ANALOG_INPUTS];
+
+#if FEATURE_ADC_INTERRUPT
+#define ANALOG_INPUT_SLOTS  (ANALOG_INPUTS*ANALOG_INPUT_EXTRUDER_WEIGHT)
+
+extern uint8            osAnalogInputSchedule[ANALOG_INPUT_SLOTS];
+extern uint8            osAnalogInputSlots;
+extern volatile uint8   osAnalogInputSlot;
+extern volatile uint    osAnalogInputFiltered[ANALOG_INPUTS];
+extern volatile uint32_t osAnalogInputUpdates[ANALOG_INPUTS];
+#endif // FEATURE_ADC_INTERRUPT
+
 extern uint8_t          pwm_pos[NUM_EXTRUDER+3]; // 0-NUM_EXTRUDER = Heater 0-NUM_EXTRUDER of extruder, NUM_EXTRUDER = Heated bed, NUM_EXTRUDER+1 Board fan, NUM_EXTRUDER+2 = Fan
 
 #if USE_ADVANCE
@@ -204,8 +215,88 @@ public:
     bool        savetosd;
     SdBaseFile  parentFound;
 
+#if FEATURE_SD_NONBLOCKING_MOUNT
+    uint8_t     mountState;
+    bool        mountAutomatic;                             // the mount has been started by an inserted card
+    millis_t    mountStartTime;
+    millis_t    mountWaitTime;                              // end of the dummy initialization of the card
+    uint32_t    mountLongestStep;                           // duration of the longest mount step [us]
+#endif // FEATURE_SD_NONBLOCKING_MOUNT
+
+#if FEATURE_SD_FAST_UPLOAD
+    uint32_t    uploadStartTime;                            // time of M28, for the transfer rate which is reported at M29
+#endif // FEATURE_SD_FAST_UPLOAD
+
+#if FEATURE_SD_BLOCK_UPLOAD
+    uint8_t     blockBuffer[SD_BLOCK_FRAME_HEADER_SIZE+SD_BLOCK_UPLOAD_SIZE+SD_BLOCK_FRAME_CRC_SIZE];
+    uint16_t    blockFramePos;                              // number of bytes of the current block which have been received
+    uint16_t    blockSequence;                              // sequence number of the next expected block
+    uint8_t     blockUnacked;                               // number of blocks which have been stored since the last acknowledgement
+    bool        blockResendPending;                         // the next expected block has been requested again
+    uint8_t     blockStopMatch;                             // number of characters of M112 which have been received between the blocks
+    bool        blockUploadActive;
+    millis_t    blockLastTime;                              // time of the last received byte
+    millis_t    blockResendTime;                            // time of the last request to send a block again
+#endif // FEATURE_SD_BLOCK_UPLOAD
+
+#if FEATURE_SD_BINARY_CACHE || FEATURE_SD_PREFLIGHT_SCAN
+    char        backgroundLine[MAX_CMD_SIZE];               // line of the binary cache conversion or of the pre-flight scan, only one of them collects a line at a time
+    uint8_t     backgroundLineUser;                         // SD_BACKGROUND_LINE_*, the user which has started to collect a line
+#endif // FEATURE_SD_BINARY_CACHE || FEATURE_SD_PREFLIGHT_SCAN
+
+#if FEATURE_SD_BINARY_CACHE
+    SdFile      convertSource;
+    SdFile      convertTarget;
+    uint32_t    convertLines;
+    uint8_t     convertBuffer[SD_BINARY_CACHE_BUFFER_SIZE];
+    uint8_t     convertBufferPos;
+    uint8_t     convertLinePos;
+    bool        convertComment;
+    bool        convertActive;
+#endif // FEATURE_SD_BINARY_CACHE
+
+#if FEATURE_SD_PREFLIGHT_SCAN
+    SdFile      preflightFile;                              // second handle of the selected file
+    uint32_t    preflightStart;                             // file position of the first command
+    uint32_t    preflightCRC;
+    uint32_t    preflightLines;                             // number of commands
+    float       preflightPosition[4];                       // X, Y and Z position of the machine and E position behind the scanned commands [mm]
+    float       preflightOffset[3];                         // difference between the G-Code coordinates and the machine position (G92) [mm]
+    float       preflightMin[3];
+    float       preflightMax[3];
+    float       preflightExtrusion;                         // sum of the E moves [mm]
+    uint8_t     preflightLinePos;
+    uint8_t     preflightBinarySize;                        // size of the binary command which is collected at the moment, 0 = not known yet
+    uint8_t     preflightState;
+    bool        preflightBinary;                            // the current command is a binary command
+    bool        preflightComment;
+    bool        preflightRelative;                          // G91
+    bool        preflightRelativeE;                         // M83
+    bool        preflightMoves;                             // the file contains at least one move
+#endif // FEATURE_SD_PREFLIGHT_SCAN
+
+#if FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
+    uint32_t    toolChangeScanPos;                          // file position up to which the scan has processed the file
+    uint32_t    toolChangePos;                              // file position behind the next tool change, 0 = no tool change found yet
+    uint32_t    toolChangeRatePos;
+    millis_t    toolChangeRateTime;
+    uint32_t    toolChangeMsPerKB;                          // average print time per KB of the file, 0 = not known yet
+    float       toolChangeTemperature[NUM_EXTRUDER];        // print temperature of the extruders in standby
+    uint8_t     toolChangeHeader[5];
+    uint8_t     toolChangeBinaryPos;
+    uint8_t     toolChangeBinarySize;
+    uint8_t     toolChangeToolPos;                          // position of the T value within the binary command, 0 = no tool change
+    uint8_t     toolChangeState;
+    uint8_t     toolChangeValue;
+    uint8_t     toolChangeDigits;                           // 1 = the T command has a number
+    uint8_t     toolChangeScanExtruder;                     // active extruder at the scan position
+    uint8_t     toolChangeExtruder;                         // extruder of the next tool change
+    bool        toolChangePreheated;
+#endif // FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
+
     SDCard();
     void initsd();
+    uint8_t serializeCommand(GCode *code,uint8_t *buf);
     void writeCommand(GCode *code);
     bool selectFile(char *filename,bool silent=false);
     void mount();
@@ -219,6 +310,10 @@ public:
         sdpos = newpos;
         file.seekSet(sdpos);
 
+#if FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
+        startToolChangeScan();
+#endif // FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
+
     } // setIndex
 
     void printStatus();
@@ -231,6 +326,41 @@ public:
     bool showFilename(const uint8_t *name);
     void automount();
 
+#if FEATURE_SD_NONBLOCKING_MOUNT
+    void mountStep();
+#endif // FEATURE_SD_NONBLOCKING_MOUNT
+
+#if FEATURE_SD_FAST_UPLOAD
+    void releaseInterruptedUploads();
+#endif // FEATURE_SD_FAST_UPLOAD
+
+#if FEATURE_SD_BINARY_CACHE
+    void startConvert(char *filename);
+    void abortConvert();
+    void convertStep();
+    void printConvertStatus();
+#endif // FEATURE_SD_BINARY_CACHE
+
+#if FEATURE_SD_PREFLIGHT_SCAN
+    void startPreflightScan();
+    void stopPreflightScan();
+    void preflightStep();
+    void printPreflightStatus();
+#endif // FEATURE_SD_PREFLIGHT_SCAN
+
+#if FEATURE_SD_BLOCK_UPLOAD
+    void startBlockUpload(char *filename);
+    void receiveBlocks();
+#endif // FEATURE_SD_BLOCK_UPLOAD
+
+#if FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
+    void startToolChangeScan();
+    void stopToolChangeScan();
+    void toolChangeScanStep();
+    void toolChangeScanBlock();
+    void toolChangeExecuted(uint8_t extruderId);
+#endif // FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
+
 #ifdef GLENN_DEBUG
     void writeToFile();
 #endif // GLENN_DEBUG
@@ -238,6 +368,45 @@ public:
 private:
     uint8_t lsRecursive(SdBaseFile *parent,uint8_t level,char *findFilename);
 
+#if FEATURE_SD_BINARY_CACHE || FEATURE_SD_PREFLIGHT_SCAN
+    inline void releaseBackgroundLine(uint8_t user)
+    {
+        if( backgroundLineUser == user ) backgroundLineUser = SD_BACKGROUND_LINE_FREE;
+
+    } // releaseBackgroundLine
+#endif // FEATURE_SD_BINARY_CACHE || FEATURE_SD_PREFLIGHT_SCAN
+
+#if FEATURE_SD_BINARY_CACHE
+    bool createBinaryCacheName(const char *source,char *target,uint8_t size);
+    void buildBinaryCacheHeader(uint8_t *header,const dir_t *source);
+    bool selectBinaryCache(SdBaseFile *parent,char *filename);
+    bool hasBinaryCacheHeader();
+    bool convertLineDone();
+    bool flushConvertBuffer();
+    void finishConvert();
+#endif // FEATURE_SD_BINARY_CACHE
+
+#if FEATURE_SD_PREFLIGHT_SCAN
+    void preflightLineDone();
+    void preflightCommand(GCode *code);
+    void finishPreflightScan();
+    bool preflightInRange(uint8_t axis);
+#endif // FEATURE_SD_PREFLIGHT_SCAN
+
+#if FEATURE_SD_BLOCK_UPLOAD
+    void processBlockFrame();
+    void sendBlockAck();
+    void requestBlockResend();
+    void stopBlockUpload();
+#endif // FEATURE_SD_BLOCK_UPLOAD
+
+#if FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
+    bool scanToolChangeByte(uint8_t data);
+    void updateToolChangeRate();
+    void checkToolChangePreheat();
+    uint32_t estimateHeatUpTime(uint8_t extruderId,float temperature);
+#endif // FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
+
 };
 
 extern SDCard sd;
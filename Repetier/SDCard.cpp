@@ -32,6 +32,26 @@ SDCard::SDCard()
     savetosd = false;
     Printer::setAutomount(false);
 
+#if FEATURE_SD_BINARY_CACHE
+    convertActive = false;
+#endif // FEATURE_SD_BINARY_CACHE
+
+#if FEATURE_SD_BINARY_CACHE || FEATURE_SD_PREFLIGHT_SCAN
+    backgroundLineUser = SD_BACKGROUND_LINE_FREE;
+#endif // FEATURE_SD_BINARY_CACHE || FEATURE_SD_PREFLIGHT_SCAN
+
+#if FEATURE_SD_BLOCK_UPLOAD
+    blockUploadActive = false;
+#endif // FEATURE_SD_BLOCK_UPLOAD
+
+#if FEATURE_SD_NONBLOCKING_MOUNT
+    mountState = SD_MOUNT_IDLE;
+#endif // FEATURE_SD_NONBLOCKING_MOUNT
+
+#if FEATURE_SD_PREFLIGHT_SCAN
+    preflightState = SD_PREFLIGHT_IDLE;
+#endif // FEATURE_SD_PREFLIGHT_SCAN
+
     //power to SD reader
 #if SDPOWER > -1
     SET_OUTPUT(SDPOWER);
@@ -51,6 +71,11 @@ void SDCard::automount()
 #if defined(SDCARDDETECT) && SDCARDDETECT>-1
     if(READ(SDCARDDETECT) != SDCARDDETECTINVERTED)
     {
+#if FEATURE_SD_NONBLOCKING_MOUNT
+        // a mount which is in progress ends with the removal of the card
+        mountState = SD_MOUNT_IDLE;
+#endif // FEATURE_SD_NONBLOCKING_MOUNT
+
         if(sdactive)   // Card removed
         {
             if( Printer::debugInfo() )
@@ -67,7 +92,11 @@ void SDCard::automount()
     }
     else
     {
+#if FEATURE_SD_NONBLOCKING_MOUNT
+        if(!sdactive && mountState == SD_MOUNT_IDLE)
+#else
         if(!sdactive)
+#endif // FEATURE_SD_NONBLOCKING_MOUNT
         {
             UI_STATUS( UI_TEXT_SD_INSERTED );
             if( Printer::debugInfo() )
@@ -76,12 +105,16 @@ void SDCard::automount()
             }
             Printer::setMenuMode(MENU_MODE_SD_MOUNTED,true);
             initsd();
-#if UI_DISPLAY_TYPE!=0
+
+#if FEATURE_SD_NONBLOCKING_MOUNT
+            // the display switches to the file list at the end of the mount
+            mountAutomatic = true;
+#elif UI_DISPLAY_TYPE!=0
             if(sdactive) {
                 Printer::setAutomount(true);
                 uid.executeAction(UI_ACTION_SD_PRINT+UI_ACTION_TOPMENU);
             }
-#endif // UI_DISPLAY_TYPE!=0
+#endif // FEATURE_SD_NONBLOCKING_MOUNT
         }
     }
 #endif // defined(SDCARDDETECT) && SDCARDDETECT>-1
@@ -93,17 +126,40 @@ void SDCard::initsd()
 {
     sdactive = false;
 
+#if FEATURE_SD_BINARY_CACHE
+    abortConvert();
+#endif // FEATURE_SD_BINARY_CACHE
+
 #if SDSS >- 1
 #if defined(SDCARDDETECT) && SDCARDDETECT>-1
     if(READ(SDCARDDETECT) != SDCARDDETECTINVERTED)
         return;
 #endif // defined(SDCARDDETECT) && SDCARDDETECT>-1
 
+#if FEATURE_SD_NONBLOCKING_MOUNT
+    // the card is mounted by mountStep()
+    mountState       = SD_MOUNT_START;
+    mountAutomatic   = false;
+    mountStartTime   = HAL::timeInMilliseconds();
+    mountLongestStep = 0;
+#else
+    millis_t    startTime = HAL::timeInMilliseconds();
+    bool        mounted;
+
+
     //fix in https://github.com/repetier/Repetier-Firmware/commit/d4e396d0f4d1b81cc4d388360be461f11ceb9edd ??
     fat.begin(SDSS, SPI_FULL_SPEED);  // dummy init of SD_CARD
     HAL::delayMilliseconds(50);       // wait for init end
 
-    if(!fat.begin(SDSS,SPI_FULL_SPEED))
+    mounted = fat.begin(SDSS,SPI_FULL_SPEED);
+    if( Printer::debugInfo() )
+    {
+        // the main loop is stalled during the whole mount
+        Com::printF(PSTR("SD mount: "),(uint32_t)(HAL::timeInMilliseconds() - startTime));
+        Com::printFLN(PSTR(" ms"));
+    }
+
+    if(!mounted)
     {
         if( Printer::debugErrors() )
         {
@@ -124,15 +180,130 @@ void SDCard::initsd()
     Printer::setMenuMode(MENU_MODE_SD_MOUNTED,true);
 
     fat.chdir();
+
+#if FEATURE_SD_FAST_UPLOAD
+    releaseInterruptedUploads();
+#endif // FEATURE_SD_FAST_UPLOAD
+
     if(selectFile((char *)"init.g",true))
     {
         startPrint();
     }
+#endif // FEATURE_SD_NONBLOCKING_MOUNT
 #endif // SDSS >- 1
 
 } // initsd
 
 
+#if FEATURE_SD_NONBLOCKING_MOUNT
+/** \brief Performs the next step of the mount which has been started by initsd(). Each step sends at most a few commands to the card or reads a few blocks. */
+void SDCard::mountStep()
+{
+    unsigned long   stepStart;
+    unsigned long   stepTime;
+    int8_t          result = 0;
+
+
+    if( mountState == SD_MOUNT_IDLE ) return;
+    if( mountState == SD_MOUNT_WAIT && HAL::timeInMilliseconds() - mountWaitTime < SD_MOUNT_DUMMY_INIT_DELAY ) return;
+
+    stepStart = HAL::timeInMicroseconds();
+    switch( mountState )
+    {
+        case SD_MOUNT_START:
+        {
+            //fix in https://github.com/repetier/Repetier-Firmware/commit/d4e396d0f4d1b81cc4d388360be461f11ceb9edd ??
+            fat.card()->initStart(SPI_FULL_SPEED,SDSS);     // dummy init of SD_CARD
+            mountState = SD_MOUNT_DUMMY_INIT;
+            break;
+        }
+        case SD_MOUNT_DUMMY_INIT:
+        {
+            // the result of the dummy init does not matter
+            if( fat.card()->initStep() != 0 )
+            {
+                mountWaitTime = HAL::timeInMilliseconds();
+                mountState    = SD_MOUNT_WAIT;
+            }
+            break;
+        }
+        case SD_MOUNT_WAIT:
+        {
+            fat.card()->initStart(SPI_FULL_SPEED,SDSS);
+            mountState = SD_MOUNT_CARD_INIT;
+            break;
+        }
+        case SD_MOUNT_CARD_INIT:
+        {
+            result = fat.card()->initStep();
+            if( result > 0 )
+            {
+                mountState = SD_MOUNT_VOLUME;
+            }
+            break;
+        }
+        case SD_MOUNT_VOLUME:
+        {
+            result = fat.vol()->init(fat.card()) ? 0 : -1;
+            mountState = SD_MOUNT_ROOT;
+            break;
+        }
+        case SD_MOUNT_ROOT:
+        {
+            if( !fat.chdir(true) )
+            {
+                result = -1;
+                break;
+            }
+            sdactive = true;
+            Printer::setMenuMode(MENU_MODE_SD_MOUNTED,true);
+
+#if FEATURE_SD_FAST_UPLOAD
+            releaseInterruptedUploads();
+#endif // FEATURE_SD_FAST_UPLOAD
+
+            if(selectFile((char *)"init.g",true))
+            {
+                startPrint();
+            }
+            mountState = SD_MOUNT_IDLE;
+            break;
+        }
+    }
+
+    stepTime = HAL::timeInMicroseconds() - stepStart;
+    if( stepTime > mountLongestStep ) mountLongestStep = stepTime;
+
+    if( result < 0 )
+    {
+        // the mount has failed
+        mountState = SD_MOUNT_IDLE;
+        if( Printer::debugErrors() )
+        {
+            Com::printFLN(Com::tSDInitFail);
+        }
+    }
+    if( mountState != SD_MOUNT_IDLE ) return;
+
+    if( Printer::debugInfo() )
+    {
+        Com::printF(PSTR("SD mount: "),(uint32_t)(HAL::timeInMilliseconds() - mountStartTime));
+        Com::printF(PSTR(" ms, longest step: "),mountLongestStep);
+        Com::printFLN(PSTR(" us"));
+    }
+
+#if UI_DISPLAY_TYPE!=0
+    if(sdactive && mountAutomatic)
+    {
+        Printer::setAutomount(true);
+        uid.executeAction(UI_ACTION_SD_PRINT+UI_ACTION_TOPMENU);
+    }
+#endif // UI_DISPLAY_TYPE!=0
+
+} // mountStep
+#endif // FEATURE_SD_NONBLOCKING_MOUNT
+
+
 void SDCard::mount()
 {
     sdmode = false;
@@ -146,13 +317,32 @@ void SDCard::unmount()
     sdmode = false;
     sdactive = false;
     savetosd = false;
+#if FEATURE_SD_BLOCK_UPLOAD
+    blockUploadActive = false;
+#endif // FEATURE_SD_BLOCK_UPLOAD
+#if FEATURE_SD_NONBLOCKING_MOUNT
+    mountState = SD_MOUNT_IDLE;
+#endif // FEATURE_SD_NONBLOCKING_MOUNT
+#if FEATURE_SD_PREFLIGHT_SCAN
+    stopPreflightScan();
+#endif // FEATURE_SD_PREFLIGHT_SCAN
+#if FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
+    stopToolChangeScan();
+#endif // FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
     Printer::setAutomount(false);
     Printer::setMenuMode(MENU_MODE_SD_MOUNTED+MENU_MODE_PAUSED+MENU_MODE_SD_PRINTING,false);
 
+#if FEATURE_SD_BINARY_CACHE
+    abortConvert();
+#endif // FEATURE_SD_BINARY_CACHE
+
 #if UI_DISPLAY_TYPE!=0
     uid.cwd[0]='/';
     uid.cwd[1]=0;
     uid.folderLevel=0;
+#if FEATURE_SD_DIRECTORY_INDEX
+    uid.sdIndexCount=0;
+#endif // FEATURE_SD_DIRECTORY_INDEX
 #endif // UI_DISPLAY_TYPE!=0
 
 } // unmount
@@ -162,6 +352,9 @@ void SDCard::startPrint()
 {
     if(!sdactive) return;
     sdmode = true;
+#if FEATURE_SD_STREAMING_READ
+    file.setStreaming(true);
+#endif // FEATURE_SD_STREAMING_READ
     Printer::setMenuMode(MENU_MODE_SD_PRINTING,true);
     Printer::setMenuMode(MENU_MODE_PAUSED,false);
     Printer::setMenuMode(MENU_MODE_PRINTING,false);
@@ -192,6 +385,13 @@ void SDCard::abortPrint()
     sdmode   = false;
     sdpos    = 0;
     filesize = 0;
+#if FEATURE_SD_STREAMING_READ
+    file.setStreaming(false);
+#endif // FEATURE_SD_STREAMING_READ
+
+#if FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
+    stopToolChangeScan();
+#endif // FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
 
 #if DEBUG_SHOW_DEVELOPMENT_LOGS
     Com::printFLN(PSTR("G-Code buffer reset"));
@@ -262,10 +462,10 @@ void SDCard::abortPrint()
 } // abortPrint
 
 
-void SDCard::writeCommand(GCode *code)
+/** \brief Serializes the given command into the binary format which is understood by GCode::parseBinary(). Returns the number of bytes or 0 in case there is nothing to store. */
+uint8_t SDCard::serializeCommand(GCode *code,uint8_t *buf)
 {
     unsigned int    sum1=0, sum2=0; // for fletcher-16 checksum
-    uint8_t         buf[100];
     uint8_t         p=2;
     int             params = 128 | (code->params & ~1);
 
@@ -275,7 +475,6 @@ void SDCard::writeCommand(GCode *code)
     warning: dereferencing type-punned pointer will break strict-aliasing rules [-Wstrict-aliasing]
     */  
 
-    file.writeError = false;
     memcopy2(buf,&params);
     //*(int*)buf = params;
     
@@ -286,7 +485,7 @@ void SDCard::writeCommand(GCode *code)
         
         p+=2;
         if(code->hasString())
-            buf[p++] = strlen(code->text);
+            buf[p++] = RMath::min((uint8_t)79,(uint8_t)strlen(code->text));
         if(code->hasM())
         {
             memcopy2(&buf[p],&code->M);
@@ -373,12 +572,18 @@ void SDCard::writeCommand(GCode *code)
         //*(float*)&buf[p] = code->J;
         p+=4;
     }
+    if(code->hasR())
+    {
+        memcopy4(&buf[p],&code->R);
+        p+=4;
+    }
     if(code->hasString())   // read 16 uint8_t into string
     {
         char *sp = code->text;
         if(code->isV2())
         {
-            uint8_t i = strlen(code->text);
+            uint8_t i = RMath::min((uint8_t)(98-p),buf[4]); // keep space for the checksum
+            buf[4] = i;
             for(; i; i--) buf[p++] = *sp++;
         }
         else
@@ -409,8 +614,22 @@ void SDCard::writeCommand(GCode *code)
         {
             Com::printErrorFLN(Com::tAPIDFinished);
         }
-*/    }
-    else
+*/      return 0;
+    }
+    return p;
+
+} // serializeCommand
+
+
+void SDCard::writeCommand(GCode *code)
+{
+    uint8_t buf[100];
+    uint8_t p;
+
+
+    file.writeError = false;
+    p = serializeCommand(code,buf);
+    if(p)
         file.write(buf,p);
 
     if (file.writeError)
@@ -504,6 +723,12 @@ bool SDCard::selectFile(char *filename, bool silent)
     if(!sdactive) return false;
     sdmode = false;
 
+#if FEATURE_SD_PREFLIGHT_SCAN
+    stopPreflightScan();
+#endif // FEATURE_SD_PREFLIGHT_SCAN
+#if FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
+    stopToolChangeScan();
+#endif // FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
     file.close();
 
     parent = *fat.vwd();
@@ -514,6 +739,16 @@ bool SDCard::selectFile(char *filename, bool silent)
         else
             oldP = filename;
 
+#if FEATURE_SD_BINARY_CACHE
+        if( selectBinaryCache( &parent, filename ) )
+        {
+            if( Printer::debugInfo() && !silent )
+            {
+                Com::printFLN( PSTR( "Using binary cache file" ) );
+            }
+        }
+#endif // FEATURE_SD_BINARY_CACHE
+
         if(!silent)
         {
             if( Printer::debugInfo() )
@@ -525,6 +760,24 @@ bool SDCard::selectFile(char *filename, bool silent)
         sdpos = 0;
         filesize = file.fileSize();
 
+#if FEATURE_SD_BINARY_CACHE
+        if( hasBinaryCacheHeader() )
+        {
+            // the header of a binary cache file is not part of the G-Codes
+            sdpos = SD_BINARY_CACHE_HEADER_SIZE;
+        }
+        file.seekSet(sdpos);
+#endif // FEATURE_SD_BINARY_CACHE
+
+#if FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
+        memset( toolChangeTemperature, 0, sizeof( toolChangeTemperature ) );
+        startToolChangeScan();
+#endif // FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
+
+#if FEATURE_SD_PREFLIGHT_SCAN
+        startPreflightScan();
+#endif // FEATURE_SD_PREFLIGHT_SCAN
+
         if( Printer::debugInfo() )
         {
             Com::printFLN(Com::tFileSelected);
@@ -567,6 +820,12 @@ void SDCard::printStatus()
 void SDCard::startWrite(char *filename)
 {
     if(!sdactive) return;
+#if FEATURE_SD_PREFLIGHT_SCAN
+    stopPreflightScan();
+#endif // FEATURE_SD_PREFLIGHT_SCAN
+#if FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
+    stopToolChangeScan();
+#endif // FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
     file.close();
     sdmode = false;
     fat.chdir();
@@ -583,6 +842,19 @@ void SDCard::startWrite(char *filename)
         UI_STATUS( UI_TEXT_UPLOADING );
         savetosd = true;
 
+#if FEATURE_SD_FAST_UPLOAD
+        // reserve a contiguous cluster run so that the upload does not need to allocate clusters block by block
+        if( !file.preallocate() )
+        {
+            if( Printer::debugInfo() )
+            {
+                Com::printFLN(PSTR("Upload without preallocation"));
+            }
+        }
+        file.setStreaming(true);
+        uploadStartTime = HAL::timeInMilliseconds();
+#endif // FEATURE_SD_FAST_UPLOAD
+
         if( Printer::debugInfo() )
         {
             Com::printFLN(Com::tWritingToFile,filename);
@@ -592,9 +864,52 @@ void SDCard::startWrite(char *filename)
 } // startWrite
 
 
+#if FEATURE_SD_FAST_UPLOAD
+/** \brief Frees the cluster runs of the uploads into the root directory which have been interrupted before M29. Such a file has been left with the size 0 and the reserved clusters. */
+void SDCard::releaseInterruptedUploads()
+{
+    SdBaseFile* root = fat.vwd();
+    SdBaseFile  entryFile;
+    dir_t       entry;
+    uint32_t    position;
+
+
+    root->rewind();
+    while( root->readDir(&entry,NULL) > 0 )
+    {
+        if( !DIR_IS_FILE(&entry) || entry.fileSize != 0 ) continue;
+        if( !entry.firstClusterLow && !entry.firstClusterHigh ) continue;
+
+        // opening the file for write frees its clusters
+        position = root->curPosition();
+        if( entryFile.open(root,(uint16_t)(position / 32 - 1),O_WRITE) )
+        {
+            entryFile.close();
+            if( Printer::debugInfo() )
+            {
+                Com::printFLN(PSTR("Released interrupted upload"));
+            }
+        }
+        root->seekSet(position);
+    }
+    root->rewind();
+
+} // releaseInterruptedUploads
+#endif // FEATURE_SD_FAST_UPLOAD
+
+
 void SDCard::finishWrite()
 {
     if(!savetosd) return; // already closed or never opened
+
+#if FEATURE_SD_FAST_UPLOAD
+    uint32_t    uploadSize = file.fileSize();
+    uint32_t    uploadTime = HAL::timeInMilliseconds() - uploadStartTime;
+
+    // release the part of the reserved cluster run which has not been used
+    file.releaseUnused();
+#endif // FEATURE_SD_FAST_UPLOAD
+
     file.sync();
     file.close();
     savetosd = false;
@@ -602,6 +917,18 @@ void SDCard::finishWrite()
     if( Printer::debugInfo() )
     {
         Com::printFLN(Com::tDoneSavingFile);
+#if FEATURE_SD_FAST_UPLOAD
+        Com::printF(PSTR("Upload: "),uploadSize);
+        Com::printF(PSTR(" bytes in "),uploadTime);
+        if( uploadTime )
+        {
+            Com::printFLN(PSTR(" ms, KB/s: "),(float)uploadSize / 1.024f / (float)uploadTime);
+        }
+        else
+        {
+            Com::printFLN(PSTR(" ms"));
+        }
+#endif // FEATURE_SD_FAST_UPLOAD
     }
 
     g_uStartOfIdle = HAL::timeInMilliseconds();
@@ -609,6 +936,223 @@ void SDCard::finishWrite()
 } // finishWrite
 
 
+#if FEATURE_SD_BLOCK_UPLOAD
+#if SD_BLOCK_UPLOAD_WINDOW * (SD_BLOCK_FRAME_HEADER_SIZE + SD_BLOCK_UPLOAD_SIZE + SD_BLOCK_FRAME_CRC_SIZE) > SERIAL_RX_BUFFER_SIZE - 1
+    #error The blocks of one SD_BLOCK_UPLOAD_WINDOW must fit into the serial receive buffer.
+#endif // SD_BLOCK_UPLOAD_WINDOW * (SD_BLOCK_FRAME_HEADER_SIZE + SD_BLOCK_UPLOAD_SIZE + SD_BLOCK_FRAME_CRC_SIZE) > SERIAL_RX_BUFFER_SIZE - 1
+
+static uint16_t updateBlockCRC(uint16_t crc,uint8_t data)
+{
+    // CRC-16/MCRF4XX: reflected CCITT polynomial 0x8408, initial value 0xFFFF
+    data ^= (uint8_t)crc;
+    data ^= data << 4;
+    return ((((uint16_t)data << 8) | (crc >> 8)) ^ (uint8_t)(data >> 4) ^ ((uint16_t)data << 3));
+
+} // updateBlockCRC
+
+
+static const char blockStopCommand[] PROGMEM = "M112";
+
+
+void SDCard::startBlockUpload(char *filename)
+{
+    startWrite(filename);
+    if(!savetosd) return; // the file could not be opened
+
+    blockFramePos      = 0;
+    blockSequence      = 0;
+    blockUnacked       = 0;
+    blockResendPending = false;
+    blockStopMatch     = 0;
+    blockLastTime      = HAL::timeInMilliseconds();
+    blockResendTime    = blockLastTime;
+    blockUploadActive  = true;
+
+    Com::printF(PSTR("SD block upload: size "),(int)SD_BLOCK_UPLOAD_SIZE);
+    Com::printFLN(PSTR(", window "),(int)SD_BLOCK_UPLOAD_WINDOW);
+
+    // the first acknowledgement tells the host to start with block 0
+    sendBlockAck();
+
+} // startBlockUpload
+
+
+void SDCard::receiveBlocks()
+{
+    millis_t    time = HAL::timeInMilliseconds();
+
+
+    if(!HAL::serialByteAvailable())
+    {
+        if(time - blockLastTime > SD_BLOCK_UPLOAD_TIMEOUT)
+        {
+            // the host has given up
+            stopBlockUpload();
+        }
+        else if(time - blockLastTime > SD_BLOCK_FRAME_TIMEOUT && time - blockResendTime > SD_BLOCK_FRAME_TIMEOUT)
+        {
+            if(blockFramePos || blockResendPending)
+            {
+                // the rest of a block or the requested block did not arrive
+                blockFramePos      = 0;
+                blockResendPending = false;
+                requestBlockResend();
+            }
+            else if(blockUnacked)
+            {
+                // the host might wait for the acknowledgement of its last blocks
+                sendBlockAck();
+            }
+        }
+        return;
+    }
+
+    blockLastTime = time;
+    while(HAL::serialByteAvailable())
+    {
+        uint8_t data = HAL::serialReadByte();
+
+        if(!blockFramePos && data != SD_BLOCK_FRAME_START)
+        {
+            // the bytes between the blocks are G-Code text of the host, unless the blocks are being resent
+            if(blockResendPending)
+            {
+                blockStopMatch = 0;
+            }
+            else if(data == pgm_read_byte(blockStopCommand+blockStopMatch))
+            {
+                blockStopMatch ++;
+                if(!pgm_read_byte(blockStopCommand+blockStopMatch))
+                {
+                    // M112 must work during the upload as well
+                    stopBlockUpload();
+                    Commands::emergencyStop();
+                    return;
+                }
+            }
+            else
+            {
+                blockStopMatch = (data == 'M');
+            }
+            continue; // wait for the start of the next block
+        }
+        blockBuffer[blockFramePos++] = data;
+
+        if(blockFramePos < SD_BLOCK_FRAME_HEADER_SIZE) continue;
+
+        uint16_t length = blockBuffer[3] | ((uint16_t)blockBuffer[4] << 8);
+        if(length > SD_BLOCK_UPLOAD_SIZE)
+        {
+            // a corrupted header - search the start of the next block
+            blockFramePos = 0;
+            requestBlockResend();
+            continue;
+        }
+        if(blockFramePos == SD_BLOCK_FRAME_HEADER_SIZE + length + SD_BLOCK_FRAME_CRC_SIZE)
+        {
+            // process at most one block per call in order to keep the main loop running
+            blockFramePos = 0;
+            processBlockFrame();
+            return;
+        }
+    }
+
+} // receiveBlocks
+
+
+void SDCard::processBlockFrame()
+{
+    uint16_t    sequence = blockBuffer[1] | ((uint16_t)blockBuffer[2] << 8);
+    uint16_t    length   = blockBuffer[3] | ((uint16_t)blockBuffer[4] << 8);
+    uint16_t    crc      = 0xFFFF;
+    uint16_t    i;
+
+
+    for(i=1; i<SD_BLOCK_FRAME_HEADER_SIZE+length; i++)
+    {
+        crc = updateBlockCRC(crc,blockBuffer[i]);
+    }
+    if(crc != (blockBuffer[i] | ((uint16_t)blockBuffer[i+1] << 8)))
+    {
+        requestBlockResend();
+        return;
+    }
+
+    if((int16_t)(sequence - blockSequence) < 0)
+    {
+        // the host repeats blocks which are stored already, it has probably missed our acknowledgement
+        sendBlockAck();
+        return;
+    }
+    if(sequence != blockSequence)
+    {
+        // a previous block is missing
+        requestBlockResend();
+        return;
+    }
+
+    blockResendPending = false;
+    blockSequence ++;
+
+    if(!length)
+    {
+        // an empty block ends the upload
+        blockUploadActive = false;
+        finishWrite();
+        sendBlockAck();
+        return;
+    }
+
+    file.writeError = false;
+    if(file.write(blockBuffer+SD_BLOCK_FRAME_HEADER_SIZE,length) != (int)length || file.writeError)
+    {
+        Com::printFLN(Com::tErrorWritingToFile);
+        stopBlockUpload();
+        return;
+    }
+
+    blockUnacked ++;
+    if(blockUnacked >= (SD_BLOCK_UPLOAD_WINDOW+1)/2)
+    {
+        sendBlockAck();
+    }
+
+} // processBlockFrame
+
+
+void SDCard::sendBlockAck()
+{
+    // all blocks before the sequence number are stored
+    blockUnacked = 0;
+    Com::printFLN(PSTR("SD block ok: "),(uint32_t)blockSequence);
+
+} // sendBlockAck
+
+
+void SDCard::requestBlockResend()
+{
+    // the host continues with the requested block, blocks which arrive until then are dropped without further requests
+    if(blockResendPending) return;
+    blockResendPending = true;
+    blockResendTime    = HAL::timeInMilliseconds();
+    blockUnacked       = 0;
+    Com::printFLN(PSTR("SD block resend: "),(uint32_t)blockSequence);
+
+} // requestBlockResend
+
+
+void SDCard::stopBlockUpload()
+{
+    blockUploadActive = false;
+
+    // keep what has been received so far
+    finishWrite();
+    Com::printFLN(PSTR("SD block upload aborted at block "),(uint32_t)blockSequence);
+
+} // stopBlockUpload
+#endif // FEATURE_SD_BLOCK_UPLOAD
+
+
 void SDCard::deleteFile(char *filename)
 {
     if(!sdactive) return;
@@ -626,6 +1170,9 @@ void SDCard::deleteFile(char *filename)
     }
 
     sdmode = false;
+#if FEATURE_SD_PREFLIGHT_SCAN
+    stopPreflightScan();
+#endif // FEATURE_SD_PREFLIGHT_SCAN
     file.close();
     if(fat.remove(filename))
     {
@@ -679,6 +1226,1073 @@ void SDCard::makeDirectory(char *filename)
 } // makeDirectory
 
 
+#if FEATURE_SD_BINARY_CACHE
+/** \brief Creates the name of the binary sibling file, e.g. "part.gcode" -> "part.bgc". Returns false in case the source is a binary sibling file itself or the name does not fit. */
+bool SDCard::createBinaryCacheName(const char *source,char *target,uint8_t size)
+{
+    const char* pExt   = strrchr(source, '.');
+    const char* pSlash = strrchr(source, '/');
+    uint8_t     length;
+
+
+    if( !pExt || (pSlash && pExt < pSlash) )
+    {
+        // the source has no extension
+        length = strlen(source);
+    }
+    else
+    {
+        length = pExt - source;
+    }
+
+    if( length + sizeof(SD_BINARY_CACHE_EXTENSION) > size )
+    {
+        return false;
+    }
+
+    memcpy(target, source, length);
+    strcpy(target + length, SD_BINARY_CACHE_EXTENSION);
+    return RFstricmp(source, target) != 0;
+
+} // createBinaryCacheName
+
+
+/** \brief The header identifies the source file via its size and its last write date/time. A binary sibling file is up to date only as long as its header matches the source file. */
+void SDCard::buildBinaryCacheHeader(uint8_t *header,const dir_t *source)
+{
+    // the first byte is 0 so that the header can not be confused with an ASCII or a binary G-Code
+    header[0] = 0;
+    header[1] = 'B';
+    header[2] = 'G';
+    header[3] = 'C';
+    memcpy(&header[4],&source->fileSize,4);
+    memcpy(&header[8],&source->lastWriteDate,2);
+    memcpy(&header[10],&source->lastWriteTime,2);
+
+} // buildBinaryCacheHeader
+
+
+/** \brief Replaces the currently opened source file by its binary sibling file in case the binary sibling file is up to date. */
+bool SDCard::selectBinaryCache(SdBaseFile *parent,char *filename)
+{
+    SdBaseFile  cache;
+    dir_t       entry;
+    char        cacheName[MAX_CMD_SIZE];
+    uint8_t     expected[SD_BINARY_CACHE_HEADER_SIZE];
+    uint8_t     header[SD_BINARY_CACHE_HEADER_SIZE];
+    bool        upToDate;
+
+
+    if( !createBinaryCacheName(filename, cacheName, sizeof(cacheName)) )
+    {
+        return false;
+    }
+    if( !file.dirEntry(&entry) )
+    {
+        return false;
+    }
+    if( !cache.open(parent, cacheName, O_READ) )
+    {
+        // there is no binary sibling file
+        return false;
+    }
+
+    buildBinaryCacheHeader(expected, &entry);
+    upToDate = cache.read(header, SD_BINARY_CACHE_HEADER_SIZE) == SD_BINARY_CACHE_HEADER_SIZE &&
+               memcmp(header, expected, SD_BINARY_CACHE_HEADER_SIZE) == 0;
+    cache.close();
+
+    if( !upToDate )
+    {
+        // the source file has been changed after the conversion
+        return false;
+    }
+
+    file.close();
+    if( file.open(parent, cacheName, O_READ) )
+    {
+        return true;
+    }
+
+    // fall back to the source file
+    file.open(parent, filename, O_READ);
+    return false;
+
+} // selectBinaryCache
+
+
+/** \brief Checks whether the currently opened file starts with the header of a binary sibling file. */
+bool SDCard::hasBinaryCacheHeader()
+{
+    uint8_t header[4];
+
+
+    file.seekSet(0);
+    if( file.read(header, 4) != 4 )
+    {
+        return false;
+    }
+    return header[0] == 0 && header[1] == 'B' && header[2] == 'G' && header[3] == 'C';
+
+} // hasBinaryCacheHeader
+
+
+void SDCard::startConvert(char *filename)
+{
+    SdBaseFile  parent;
+    char        cacheName[MAX_CMD_SIZE];
+
+
+    if(!sdactive) return;
+
+    if( convertActive )
+    {
+        if( Printer::debugErrors() )
+        {
+            Com::printFLN( PSTR( "M3400: a conversion is in progress already" ) );
+        }
+        return;
+    }
+
+    if( !createBinaryCacheName(filename, cacheName, sizeof(cacheName)) )
+    {
+        if( Printer::debugErrors() )
+        {
+            Com::printFLN( PSTR( "M3400: this file can not be converted" ) );
+        }
+        return;
+    }
+
+    parent = *fat.vwd();
+    if( !convertSource.open(&parent, filename, O_READ) )
+    {
+        if( Printer::debugErrors() )
+        {
+            Com::printFLN(Com::tFileOpenFailed);
+        }
+        return;
+    }
+
+    if( !convertTarget.open(&parent, cacheName, O_CREAT | O_WRITE | O_TRUNC) )
+    {
+        convertSource.close();
+        if( Printer::debugErrors() )
+        {
+            Com::printFLN(Com::tOpenFailedFile,cacheName);
+        }
+        return;
+    }
+
+    // the header remains invalid until the conversion has been completed
+    memset(convertBuffer, 0, SD_BINARY_CACHE_HEADER_SIZE);
+    convertBufferPos = SD_BINARY_CACHE_HEADER_SIZE;
+    convertLinePos   = 0;
+    convertLines     = 0;
+    convertComment   = false;
+    convertActive    = true;
+
+    if( Printer::debugInfo() )
+    {
+        Com::printF( PSTR( "M3400: converting " ), filename );
+        Com::printFLN( PSTR( " to " ), cacheName );
+    }
+
+} // startConvert
+
+
+void SDCard::abortConvert()
+{
+    if( !convertActive ) return;
+    convertActive = false;
+    releaseBackgroundLine( SD_BACKGROUND_LINE_CONVERT );
+
+    convertSource.close();
+    if( sdactive )
+    {
+        // an incomplete binary sibling file is useless
+        convertTarget.remove();
+    }
+    convertTarget.close();
+
+    if( Printer::debugInfo() )
+    {
+        Com::printFLN( PSTR( "M3400: conversion aborted" ) );
+    }
+
+} // abortConvert
+
+
+/** \brief Converts the next part of the source file. The conversion is performed only while nothing is printed, milled or written to the SD card. */
+void SDCard::convertStep()
+{
+    uint8_t budget = SD_BINARY_CACHE_BYTES_PER_STEP;
+    int16_t n;
+    char    ch;
+
+
+    if( !convertActive ) return;
+    if( sdmode || savetosd || PrintLine::hasLines() ) return;
+
+    // the pre-flight scan has not finished its line yet
+    if( backgroundLineUser == SD_BACKGROUND_LINE_PREFLIGHT ) return;
+
+    while( budget-- )
+    {
+        n = convertSource.read();
+        if( n == -1 )
+        {
+            if( convertSource.curPosition() < convertSource.fileSize() )
+            {
+                if( Printer::debugErrors() )
+                {
+                    Com::printFLN(Com::tSDReadError);
+                }
+                abortConvert();
+                return;
+            }
+
+            // end of file
+            if( convertLineDone() )
+            {
+                finishConvert();
+            }
+            return;
+        }
+
+        ch = (char)n;
+
+        // use the same line end detection as GCode::readFromSD()
+        if( ch == '\n' || ch == '\r' || (!convertComment && ch == ':') )
+        {
+            if( !convertLineDone() ) return;
+            continue;
+        }
+        if( ch == ';' ) convertComment = true; // ignore new data until lineend
+        if( convertComment ) continue;
+
+        if( convertLinePos < MAX_CMD_SIZE - 1 )
+        {
+            backgroundLineUser = SD_BACKGROUND_LINE_CONVERT;
+            backgroundLine[convertLinePos++] = ch;
+        }
+    }
+
+} // convertStep
+
+
+/** \brief Parses the collected line and appends its binary representation to the output buffer. */
+bool SDCard::convertLineDone()
+{
+    GCode       code;
+    uint8_t     buf[100];
+    uint8_t     p = 0;
+    uint32_t    actLineNumber;
+    bool        waitUntilAllCommandsAreParsed;
+
+
+    convertComment = false;
+    if( !convertLinePos )
+    {
+        // empty line
+        return true;
+    }
+    backgroundLine[convertLinePos] = 0;
+    convertLinePos = 0;
+
+    // parsing must not influence the processing of the serial commands
+    actLineNumber                 = GCode::actLineNumber;
+    waitUntilAllCommandsAreParsed = GCode::waitUntilAllCommandsAreParsed;
+
+    if( code.parseAscii(backgroundLine) )
+    {
+        p = serializeCommand(&code, buf);
+    }
+
+    GCode::actLineNumber                 = actLineNumber;
+    GCode::waitUntilAllCommandsAreParsed = waitUntilAllCommandsAreParsed;
+    releaseBackgroundLine( SD_BACKGROUND_LINE_CONVERT );
+
+    if( !p )
+    {
+        // comments and line numbers are not stored
+        return true;
+    }
+
+    if( convertBufferPos + p > SD_BINARY_CACHE_BUFFER_SIZE && !flushConvertBuffer() )
+    {
+        return false;
+    }
+    memcpy(&convertBuffer[convertBufferPos], buf, p);
+    convertBufferPos += p;
+    convertLines ++;
+    return true;
+
+} // convertLineDone
+
+
+bool SDCard::flushConvertBuffer()
+{
+    if( convertBufferPos && convertTarget.write(convertBuffer, convertBufferPos) != convertBufferPos )
+    {
+        if( Printer::debugErrors() )
+        {
+            Com::printFLN(Com::tErrorWritingToFile);
+        }
+        abortConvert();
+        return false;
+    }
+    convertBufferPos = 0;
+    return true;
+
+} // flushConvertBuffer
+
+
+void SDCard::finishConvert()
+{
+    dir_t   entry;
+
+
+    if( !flushConvertBuffer() ) return;
+
+    if( !convertSource.dirEntry(&entry) )
+    {
+        abortConvert();
+        return;
+    }
+
+    // the binary sibling file becomes valid through its header
+    buildBinaryCacheHeader(convertBuffer, &entry);
+    if( !convertTarget.seekSet(0) || convertTarget.write(convertBuffer, SD_BINARY_CACHE_HEADER_SIZE) != SD_BINARY_CACHE_HEADER_SIZE || !convertTarget.sync() )
+    {
+        if( Printer::debugErrors() )
+        {
+            Com::printFLN(Com::tErrorWritingToFile);
+        }
+        abortConvert();
+        return;
+    }
+
+    if( Printer::debugInfo() )
+    {
+        Com::printF( PSTR( "M3400: conversion finished, lines: " ), convertLines );
+        Com::printF( PSTR( ", size: " ), convertSource.fileSize() );
+        Com::printFLN( PSTR( " -> " ), convertTarget.fileSize() );
+    }
+
+    convertActive = false;
+    convertSource.close();
+    convertTarget.close();
+
+} // finishConvert
+
+
+void SDCard::printConvertStatus()
+{
+    if( Printer::debugInfo() )
+    {
+        if( convertActive )
+        {
+            Com::printF( PSTR( "M3400: converting, lines: " ), convertLines );
+            Com::printF( PSTR( ", position: " ), convertSource.curPosition() );
+            Com::printFLN( Com::tSlash, convertSource.fileSize() );
+        }
+        else
+        {
+            Com::printFLN( PSTR( "M3400: no conversion in progress" ) );
+        }
+    }
+
+} // printConvertStatus
+#endif // FEATURE_SD_BINARY_CACHE
+
+
+#if FEATURE_SD_PREFLIGHT_SCAN
+static uint32_t updatePreflightCRC(uint32_t crc,uint8_t data)
+{
+    // CRC-32 (IEEE 802.3): reflected polynomial 0xEDB88320, the caller starts with 0xFFFFFFFF and inverts the result
+    crc ^= data;
+    for( uint8_t i=0; i<8; i++ )
+    {
+        crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+    }
+    return crc;
+
+} // updatePreflightCRC
+
+
+/** \brief Starts the scan of the selected file, the scan is performed by preflightStep() while the printer is idle. */
+void SDCard::startPreflightScan()
+{
+    preflightFile = file;
+    preflightFile.seekSet(0);
+
+    preflightStart      = sdpos;
+    preflightCRC        = 0xFFFFFFFF;
+    preflightLines      = 0;
+    preflightExtrusion  = 0;
+    preflightLinePos    = 0;
+    preflightBinarySize = 0;
+    preflightBinary     = false;
+    preflightComment    = false;
+    preflightRelative   = false;
+    preflightRelativeE  = false;
+    preflightMoves      = false;
+    memset( preflightPosition, 0, sizeof( preflightPosition ) );
+    memset( preflightOffset, 0, sizeof( preflightOffset ) );
+    preflightState      = SD_PREFLIGHT_RUNNING;
+
+} // startPreflightScan
+
+
+void SDCard::stopPreflightScan()
+{
+    preflightFile.close();
+    releaseBackgroundLine( SD_BACKGROUND_LINE_PREFLIGHT );
+    preflightState = SD_PREFLIGHT_IDLE;
+
+} // stopPreflightScan
+
+
+/** \brief Scans the next part of the selected file: the CRC32 covers all bytes of the file, the commands are parsed like the commands of the print. The bytes are read one by one from the block cache, so that the scan does not need a buffer on the stack. */
+void SDCard::preflightStep()
+{
+    uint8_t     budget = SD_PREFLIGHT_BYTES_PER_STEP;
+    int16_t     n;
+    uint8_t     ch;
+
+
+    if( preflightState != SD_PREFLIGHT_RUNNING ) return;
+    if( sdmode || savetosd || PrintLine::hasLines() ) return;
+
+    // the binary cache conversion has not finished its line yet
+    if( backgroundLineUser == SD_BACKGROUND_LINE_CONVERT ) return;
+
+    while( budget-- )
+    {
+        n = preflightFile.read();
+        if( n == -1 )
+        {
+            if( preflightFile.curPosition() < preflightFile.fileSize() )
+            {
+                preflightFile.close();
+                releaseBackgroundLine( SD_BACKGROUND_LINE_PREFLIGHT );
+                preflightState = SD_PREFLIGHT_READ_ERROR;
+
+                if( Printer::debugErrors() )
+                {
+                    Com::printFLN(Com::tSDReadError);
+                }
+                UI_ERROR( UI_TEXT_SD_READ_ERROR );
+                return;
+            }
+
+            // end of file
+            finishPreflightScan();
+            return;
+        }
+
+        ch           = (uint8_t)n;
+        preflightCRC = updatePreflightCRC( preflightCRC, ch );
+
+        // the header of a binary cache file is not part of the G-Codes
+        if( preflightFile.curPosition() <= preflightStart ) continue;
+
+        if( preflightBinary )
+        {
+            // use the same binary detection as GCode::readFromSD()
+            if( preflightLinePos < MAX_CMD_SIZE ) backgroundLine[preflightLinePos] = ch;
+            preflightLinePos ++;
+
+            if( preflightLinePos == 4 || preflightLinePos == 5 )
+            {
+                preflightBinarySize = GCode::computeBinarySize( backgroundLine );
+            }
+            if( preflightLinePos == preflightBinarySize )
+            {
+                preflightLineDone();
+            }
+            continue;
+        }
+
+        if( !preflightLinePos && !preflightComment && (ch & 128) )
+        {
+            preflightBinary     = true;
+            preflightBinarySize = 0;
+            backgroundLineUser  = SD_BACKGROUND_LINE_PREFLIGHT;
+            backgroundLine[0]   = ch;
+            preflightLinePos    = 1;
+            continue;
+        }
+
+        // use the same line end detection as GCode::readFromSD()
+        if( ch == '\n' || ch == '\r' || (!preflightComment && ch == ':') )
+        {
+            preflightLineDone();
+            continue;
+        }
+        if( ch == ';' ) preflightComment = true; // ignore new data until lineend
+        if( preflightComment ) continue;
+
+        if( preflightLinePos < MAX_CMD_SIZE - 1 )
+        {
+            backgroundLineUser = SD_BACKGROUND_LINE_PREFLIGHT;
+            backgroundLine[preflightLinePos++] = ch;
+        }
+    }
+
+} // preflightStep
+
+
+/** \brief Parses the collected ASCII line or binary command. */
+void SDCard::preflightLineDone()
+{
+    GCode       code;
+    uint32_t    actLineNumber;
+    bool        waitUntilAllCommandsAreParsed;
+    bool        parsed = false;
+
+
+    // parsing must not influence the processing of the serial commands
+    actLineNumber                 = GCode::actLineNumber;
+    waitUntilAllCommandsAreParsed = GCode::waitUntilAllCommandsAreParsed;
+
+    if( preflightBinary )
+    {
+        if( preflightBinarySize <= MAX_CMD_SIZE )
+        {
+            parsed = code.parseBinary( (uint8_t*)backgroundLine );
+        }
+    }
+    else if( preflightLinePos )
+    {
+        backgroundLine[preflightLinePos] = 0;
+        parsed = code.parseAscii( backgroundLine );
+    }
+
+    GCode::actLineNumber                 = actLineNumber;
+    GCode::waitUntilAllCommandsAreParsed = waitUntilAllCommandsAreParsed;
+    releaseBackgroundLine( SD_BACKGROUND_LINE_PREFLIGHT );
+
+    preflightLinePos    = 0;
+    preflightBinarySize = 0;
+    preflightBinary     = false;
+    preflightComment    = false;
+
+    if( parsed && (code.hasG() || code.hasM() || code.hasT()) )
+    {
+        preflightLines ++;
+        preflightCommand( &code );
+    }
+
+} // preflightLineDone
+
+
+/** \brief Follows the position of the machine through the given command. */
+void SDCard::preflightCommand(GCode *code)
+{
+    float   value[3] = { code->X, code->Y, code->Z };
+    bool    has[3]   = { code->hasX(), code->hasY(), code->hasZ() };
+    float   e;
+
+
+    if( code->hasM() )
+    {
+        if( code->M == 82 ) preflightRelativeE = false;
+        if( code->M == 83 ) preflightRelativeE = true;
+        return;
+    }
+    if( !code->hasG() ) return;
+
+    switch( code->G )
+    {
+        case 0:
+        case 1:
+        case 2:
+        case 3:
+        {
+            // arcs are followed to their end point only
+            for( uint8_t axis=0; axis<3; axis++ )
+            {
+                if( has[axis] )
+                {
+                    if( preflightRelative ) preflightPosition[axis] += value[axis];
+                    else                    preflightPosition[axis] = value[axis] - preflightOffset[axis];
+                }
+
+                if( !preflightMoves || preflightPosition[axis] < preflightMin[axis] ) preflightMin[axis] = preflightPosition[axis];
+                if( !preflightMoves || preflightPosition[axis] > preflightMax[axis] ) preflightMax[axis] = preflightPosition[axis];
+            }
+            preflightMoves = true;
+
+            if( code->hasE() )
+            {
+                // E is always relative in relative coordinates mode, see Printer::relativeExtruderCoordinateMode
+                e = ( preflightRelative || preflightRelativeE ) ? code->E : code->E - preflightPosition[E_AXIS];
+                preflightPosition[E_AXIS] += e;
+                preflightExtrusion        += e;
+            }
+            break;
+        }
+        case 28:
+        {
+            // the homed axes are at the origin of the machine
+            for( uint8_t axis=0; axis<3; axis++ )
+            {
+                if( code->hasNoXYZ() || has[axis] ) preflightPosition[axis] = 0;
+            }
+            break;
+        }
+        case 90:
+        {
+            preflightRelative = false;
+            break;
+        }
+        case 91:
+        {
+            preflightRelative = true;
+            break;
+        }
+        case 92:
+        {
+            // G92 moves the origin of the coordinates, not the machine
+            for( uint8_t axis=0; axis<3; axis++ )
+            {
+                if( has[axis] ) preflightOffset[axis] = value[axis] - preflightPosition[axis];
+            }
+            if( code->hasE() ) preflightPosition[E_AXIS] = code->E;
+            break;
+        }
+    }
+
+} // preflightCommand
+
+
+void SDCard::finishPreflightScan()
+{
+    preflightLineDone();
+    preflightFile.close();
+    preflightCRC   = ~preflightCRC;
+    preflightState = SD_PREFLIGHT_DONE;
+
+    printPreflightStatus();
+
+    for( uint8_t axis=0; axis<3; axis++ )
+    {
+        if( !preflightInRange( axis ) )
+        {
+            UI_STATUS( UI_TEXT_PREFLIGHT_OUT_OF_RANGE );
+            return;
+        }
+    }
+    UI_STATUS( UI_TEXT_PREFLIGHT_OK );
+
+} // finishPreflightScan
+
+
+/** \brief Checks whether the positions of the scanned moves are within the travel range of the given axis. */
+bool SDCard::preflightInRange(uint8_t axis)
+{
+    if( !preflightMoves ) return true;
+    return preflightMin[axis] >= Printer::minMM[axis] && preflightMax[axis] <= Printer::minMM[axis] + Printer::lengthMM[axis];
+
+} // preflightInRange
+
+
+void SDCard::printPreflightStatus()
+{
+    char    crc[9];
+    bool    inRange = true;
+
+
+    if( !Printer::debugInfo() ) return;
+
+    if( preflightState == SD_PREFLIGHT_IDLE )
+    {
+        Com::printFLN( PSTR( "M3417: no file selected" ) );
+        return;
+    }
+    if( preflightState == SD_PREFLIGHT_READ_ERROR )
+    {
+        Com::printFLN( PSTR( "M3417: read error" ) );
+        return;
+    }
+    if( preflightState == SD_PREFLIGHT_RUNNING )
+    {
+        Com::printF( PSTR( "M3417: scanning, lines: " ), preflightLines );
+        Com::printF( PSTR( ", position: " ), preflightFile.curPosition() );
+        Com::printFLN( Com::tSlash, preflightFile.fileSize() );
+        return;
+    }
+
+    for( uint8_t i=0; i<8; i++ )
+    {
+        uint8_t digit = (preflightCRC >> (28 - 4 * i)) & 15;
+        crc[i] = digit < 10 ? '0' + digit : 'A' + digit - 10;
+    }
+    crc[8] = 0;
+
+    Com::printF( PSTR( "M3417: CRC32: " ), crc );
+    Com::printF( PSTR( ", lines: " ), preflightLines );
+    Com::printFLN( PSTR( ", E: " ), preflightExtrusion, 1 );
+
+    if( !preflightMoves )
+    {
+        Com::printFLN( PSTR( "M3417: no moves" ) );
+        return;
+    }
+    for( uint8_t axis=0; axis<3; axis++ )
+    {
+        Com::printF( PSTR( "M3417: " ), axis == X_AXIS ? "X" : axis == Y_AXIS ? "Y" : "Z" );
+        Com::printF( PSTR( ": " ), preflightMin[axis], 2 );
+        Com::printF( PSTR( " ... " ), preflightMax[axis], 2 );
+
+        if( !preflightInRange( axis ) )
+        {
+            inRange = false;
+            Com::printF( PSTR( " [mm], out of range: " ), Printer::minMM[axis], 2 );
+            Com::printFLN( PSTR( " ... " ), Printer::minMM[axis] + Printer::lengthMM[axis], 2 );
+        }
+        else
+        {
+            Com::printFLN( PSTR( " [mm]" ) );
+        }
+    }
+    if( inRange )   Com::printFLN( PSTR( "M3417: all positions are within the range of the machine" ) );
+    else            Com::printFLN( PSTR( "M3417: the file leaves the range of the machine" ) );
+
+} // printPreflightStatus
+#endif // FEATURE_SD_PREFLIGHT_SCAN
+
+
+#if FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
+/** \brief Starts the scan for the next tool change at the current print position. */
+void SDCard::startToolChangeScan()
+{
+    toolChangeScanPos      = sdpos;
+    toolChangePos          = 0;
+    toolChangeRatePos      = sdpos;
+    toolChangeRateTime     = HAL::timeInMilliseconds();
+    toolChangeMsPerKB      = 0;
+    toolChangeState        = TOOLCHANGE_SCAN_LINE_START;
+    toolChangeScanExtruder = Extruder::current->id;
+    toolChangePreheated    = false;
+
+} // startToolChangeScan
+
+
+void SDCard::stopToolChangeScan()
+{
+    toolChangePos = 0;
+
+} // stopToolChangeScan
+
+
+/** \brief Preheats the next extruder as soon as the remaining print time until the next tool change is not longer than its heat-up time. The file itself is scanned by toolChangeScanBlock() only. */
+void SDCard::toolChangeScanStep()
+{
+    if( !sdmode ) return;
+
+    updateToolChangeRate();
+
+    if( toolChangePos )
+    {
+        // the next tool change is known already, we do not scan further until it has been executed
+        checkToolChangePreheat();
+    }
+
+} // toolChangeScanStep
+
+
+/** \brief Scans the rest of the block which the print has just fetched for the next tool change. The scan uses the block cache of the volume as it has been filled by the print,
+    so it issues no command to the card and neither evicts the block of the print nor interrupts a multi-block read of the print. */
+void SDCard::toolChangeScanBlock()
+{
+    const uint8_t*  data       = file.cachedBlock();
+    uint32_t        blockStart = (sdpos - 1) & ~(uint32_t)511;
+    uint16_t        offset;
+    uint16_t        end;
+
+
+    if( !data ) return;
+
+    if( toolChangeScanPos < blockStart )
+    {
+        // the print has skipped a part of the file, the scan continues at this block
+        toolChangeScanPos = blockStart;
+        toolChangeState   = TOOLCHANGE_SCAN_LINE_START;
+    }
+
+    offset = toolChangeScanPos - blockStart;
+    end    = filesize - blockStart < 512 ? filesize - blockStart : 512;
+
+    while( offset < end )
+    {
+        if( scanToolChangeByte( data[offset ++] ) )
+        {
+            if( toolChangeValue >= NUM_EXTRUDER || toolChangeValue == toolChangeScanExtruder ) continue;
+
+            if( !toolChangePos && blockStart + offset > sdpos )
+            {
+                // the first tool change which the print has not read yet is preheated, further tool changes within this block are not
+                toolChangeExtruder = toolChangeValue;
+                toolChangePos      = blockStart + offset;
+            }
+            toolChangeScanExtruder = toolChangeValue;
+        }
+    }
+    toolChangeScanPos = blockStart + end;
+
+    if( toolChangePos )
+    {
+        checkToolChangePreheat();
+    }
+
+} // toolChangeScanBlock
+
+
+/** \brief Drops the previous extruder to its standby temperature and lets the new extruder return to its print temperature. This is called for each T command of the SD print, before the new extruder is selected. */
+void SDCard::toolChangeExecuted(uint8_t extruderId)
+{
+    uint8_t     previousId = Extruder::current->id;
+    float       temperature;
+
+
+    if( extruderId >= NUM_EXTRUDER || extruderId == previousId ) return;
+
+    if( toolChangePos && toolChangeExtruder == extruderId )
+    {
+        // the scan looks for the next tool change behind this one
+        toolChangePos       = 0;
+        toolChangePreheated = false;
+    }
+
+    temperature = extruder[previousId].tempControl.targetTemperatureC;
+    if( temperature > TOOLCHANGE_STANDBY_TEMPERATURE )
+    {
+        toolChangeTemperature[previousId] = temperature;
+        Extruder::setTemperatureForExtruder( TOOLCHANGE_STANDBY_TEMPERATURE, previousId, false );
+    }
+
+    temperature = toolChangeTemperature[extruderId];
+    if( temperature > TOOLCHANGE_STANDBY_TEMPERATURE && extruder[extruderId].tempControl.targetTemperatureC == TOOLCHANGE_STANDBY_TEMPERATURE )
+    {
+        // the preheating has been too late or the tool change has not been found by the scan - a temperature which the file has set after the parking is kept
+        Extruder::setTemperatureForExtruder( temperature, extruderId, false );
+    }
+
+    if( extruder[extruderId].tempControl.targetTemperatureC > TOOLCHANGE_STANDBY_TEMPERATURE )
+    {
+        // the new extruder must not print with its standby temperature
+#if FEATURE_ASYNC_HEATUP
+        Commands::pendingHeatUp |= 1 << extruderId;
+#else
+        Commands::waitForExtruderTemperature( &extruder[extruderId] );
+#endif // FEATURE_ASYNC_HEATUP
+    }
+
+} // toolChangeExecuted
+
+
+/** \brief Processes the next byte of the scan. Returns true when the byte completes a T command, whose extruder is stored in toolChangeValue. */
+bool SDCard::scanToolChangeByte(uint8_t data)
+{
+    switch( toolChangeState )
+    {
+        case TOOLCHANGE_SCAN_LINE_START:
+        {
+            if( data & 128 )
+            {
+                // use the same binary detection as GCode::readFromSD()
+                memset( toolChangeHeader, 0, sizeof( toolChangeHeader ) );
+                toolChangeHeader[0]  = data;
+                toolChangeBinaryPos  = 1;
+                toolChangeBinarySize = 0;
+                toolChangeToolPos    = 0;
+                toolChangeState      = TOOLCHANGE_SCAN_BINARY;
+            }
+            else if( data == 'T' )
+            {
+                toolChangeValue  = 0;
+                toolChangeDigits = 0;
+                toolChangeState  = TOOLCHANGE_SCAN_TOOL;
+            }
+            else if( data != ' ' && data != '\t' && data != '\n' && data != '\r' )
+            {
+                toolChangeState = TOOLCHANGE_SCAN_SKIP_LINE;
+            }
+            return false;
+        }
+        case TOOLCHANGE_SCAN_TOOL:
+        {
+            if( data >= '0' && data <= '9' )
+            {
+                toolChangeValue  = toolChangeValue < 25 ? toolChangeValue * 10 + (data - '0') : 255;
+                toolChangeDigits = 1;
+                return false;
+            }
+            if( data == '\n' || data == '\r' )
+            {
+                toolChangeState = TOOLCHANGE_SCAN_LINE_START;
+                return toolChangeDigits;
+            }
+
+            toolChangeState = TOOLCHANGE_SCAN_SKIP_LINE;
+            if( data == ' ' || data == '\t' || data == ';' )
+            {
+                return toolChangeDigits;
+            }
+            return false;
+        }
+        case TOOLCHANGE_SCAN_SKIP_LINE:
+        {
+            if( data == '\n' || data == '\r' )
+            {
+                toolChangeState = TOOLCHANGE_SCAN_LINE_START;
+            }
+            return false;
+        }
+        case TOOLCHANGE_SCAN_BINARY:
+        {
+            uint16_t    bitfield;
+            uint8_t     pos = toolChangeBinaryPos ++;
+
+
+            if( pos < sizeof( toolChangeHeader ) ) toolChangeHeader[pos] = data;
+            if( pos == 3 || pos == 4 )
+            {
+                toolChangeBinarySize = GCode::computeBinarySize( (char*)toolChangeHeader );
+            }
+            if( pos == 4 )
+            {
+                bitfield = toolChangeHeader[0] | ((uint16_t)toolChangeHeader[1] << 8);
+                if( (bitfield & 512) && !(bitfield & 6) )
+                {
+                    // a T command without M or G, see GCode::parseBinary() for the order of the parameters
+                    toolChangeToolPos = 2;
+                    if( bitfield & 4096 )
+                    {
+                        toolChangeToolPos += 2;
+                        if( bitfield & 32768 ) toolChangeToolPos ++;
+                    }
+                    if( bitfield & 1 )      toolChangeToolPos += 2;
+                    if( bitfield & 8 )      toolChangeToolPos += 4;
+                    if( bitfield & 16 )     toolChangeToolPos += 4;
+                    if( bitfield & 32 )     toolChangeToolPos += 4;
+                    if( bitfield & 64 )     toolChangeToolPos += 4;
+                    if( bitfield & 256 )    toolChangeToolPos += 4;
+                    if( toolChangeToolPos <= pos ) toolChangeValue = toolChangeHeader[toolChangeToolPos];
+                }
+            }
+            if( toolChangeToolPos > 4 && pos == toolChangeToolPos )
+            {
+                toolChangeValue = data;
+            }
+            if( toolChangeBinaryPos == toolChangeBinarySize )
+            {
+                toolChangeState = TOOLCHANGE_SCAN_LINE_START;
+                return toolChangeToolPos != 0;
+            }
+            return false;
+        }
+    }
+    return false;
+
+} // scanToolChangeByte
+
+
+/** \brief Measures how fast the print proceeds within the file. */
+void SDCard::updateToolChangeRate()
+{
+    millis_t    now = HAL::timeInMilliseconds();
+    uint32_t    msPerKB;
+
+
+    if( now - toolChangeRateTime < 10000 ) return;
+
+#if FEATURE_PAUSE_PRINTING
+    if( g_pauseStatus == PAUSE_STATUS_NONE )
+#endif // FEATURE_PAUSE_PRINTING
+    {
+        if( sdpos > toolChangeRatePos )
+        {
+            msPerKB = (now - toolChangeRateTime) * 1024 / (sdpos - toolChangeRatePos);
+            toolChangeMsPerKB = toolChangeMsPerKB ? (toolChangeMsPerKB * 3 + msPerKB) / 4 : msPerKB;
+        }
+    }
+
+    toolChangeRatePos  = sdpos;
+    toolChangeRateTime = now;
+
+} // updateToolChangeRate
+
+
+/** \brief Preheats the extruder of the next tool change when the estimated time until the tool change is not longer than its heat-up time. */
+void SDCard::checkToolChangePreheat()
+{
+    float       temperature = toolChangeTemperature[toolChangeExtruder];
+    uint32_t    remainingTime;
+    uint32_t    heatUpTime;
+
+
+    if( toolChangePreheated ) return;
+    if( temperature <= extruder[toolChangeExtruder].tempControl.targetTemperatureC ||
+        extruder[toolChangeExtruder].tempControl.targetTemperatureC != TOOLCHANGE_STANDBY_TEMPERATURE )
+    {
+        // the print temperature of this extruder is not known, it is at its print temperature already or the file has set its temperature after it has been parked
+        toolChangePreheated = true;
+        return;
+    }
+
+    remainingTime = PrintLine::queuedTimeInMilliseconds();
+    if( sdpos < toolChangePos && toolChangeMsPerKB )
+    {
+        // the part of the file until the tool change has not been read yet
+        remainingTime += ((toolChangePos - sdpos) >> 4) * toolChangeMsPerKB >> 6;
+    }
+
+    heatUpTime = estimateHeatUpTime( toolChangeExtruder, temperature ) + TOOLCHANGE_PREHEAT_MARGIN * 1000UL;
+    if( remainingTime > heatUpTime ) return;
+
+    if( Printer::debugInfo() )
+    {
+        Com::printF( PSTR( "Preheating extruder " ), (int)toolChangeExtruder );
+        Com::printF( PSTR( " for the tool change in " ), (int32_t)(remainingTime / 1000) );
+        Com::printFLN( PSTR( " s" ) );
+    }
+    Extruder::setTemperatureForExtruder( temperature, toolChangeExtruder, false );
+    toolChangePreheated = true;
+
+} // checkToolChangePreheat
+
+
+/** \brief Estimates the time in milliseconds which the extruder needs to heat up to the given temperature with full power. */
+uint32_t SDCard::estimateHeatUpTime(uint8_t extruderId,float temperature)
+{
+    TemperatureController*  tc          = &extruder[extruderId].tempControl;
+    float                   current     = tc->currentTemperatureC;
+
+
+    if( current >= temperature ) return 0;
+
+#if FEATURE_HEAT_MODEL_CONTROL
+    if( tc->modelHeatRate > 0 && tc->modelLossRate > 0 )
+    {
+        // the temperature which would be reached with full power
+        float   limit = HEATER_MODEL_AMBIENT_TEMPERATURE + tc->modelHeatRate * tc->pidMax / (255.0f * tc->modelLossRate);
+
+        if( limit > temperature + 1.0f )
+        {
+            return (uint32_t)((log( (limit - current) / (limit - temperature) ) / tc->modelLossRate + tc->modelDeadTime) * 1000.0f);
+        }
+    }
+#endif // FEATURE_HEAT_MODEL_CONTROL
+
+    return (uint32_t)((temperature - current) / TOOLCHANGE_PREHEAT_HEAT_RATE * 1000.0f);
+
+} // estimateHeatUpTime
+#endif // FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
+
+
 #ifdef GLENN_DEBUG
 void SDCard::writeToFile()
 {
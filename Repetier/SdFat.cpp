@@ -325,9 +325,26 @@ bool SdFat::truncate(const char* path, uint32_t length) {
 SdBaseFile* SdBaseFile::cwd_ = 0;
 // callback function for date/time
 void (*SdBaseFile::dateTime_)(uint16_t* date, uint16_t* time) = 0;
+#if FEATURE_SD_NAME_INDEX
+// hash index of the names in the last searched directory
+uint16_t SdBaseFile::nameIndexPos_[SD_NAME_INDEX_SIZE];
+uint8_t SdBaseFile::nameIndexTag_[SD_NAME_INDEX_SIZE];
+uint32_t SdBaseFile::nameIndexCluster_;
+uint16_t SdBaseFile::nameIndexEnd_;
+bool SdBaseFile::nameIndexValid_ = false;
+bool SdBaseFile::nameIndexComplete_;
+#endif  // FEATURE_SD_NAME_INDEX
+#if FEATURE_SD_DIRECTORY_INDEX
+uint8_t SdBaseFile::dirChangeCount_ = 0;
+#endif  // FEATURE_SD_DIRECTORY_INDEX
 //------------------------------------------------------------------------------
 // add a cluster to a file
 bool SdBaseFile::addCluster() {
+#if FEATURE_SD_FAST_UPLOAD
+  // a file which is written as stream reserves a run of clusters at once
+  // and falls back to single clusters if there is no free run nearby
+  if (!(flags_ & F_STREAM) || !addClusterRun())
+#endif  // FEATURE_SD_FAST_UPLOAD
   if (!vol_->allocContiguous(1, &curCluster_)) {
     DBG_FAIL_MACRO;
     goto fail;
@@ -494,6 +511,89 @@ bool SdBaseFile::createContiguous(SdBaseFile* dirFile,
  fail:
   return false;
 }
+#if FEATURE_SD_FAST_UPLOAD
+//------------------------------------------------------------------------------
+// Add a run of SD_FAST_UPLOAD_PREALLOCATION KB to the chain of a file.
+// The search for a free run is limited to 16 times the size of the run.
+bool SdBaseFile::addClusterRun() {
+  uint32_t count = ((((uint32_t)SD_FAST_UPLOAD_PREALLOCATION << 10) - 1)
+                    >> (vol_->clusterSizeShift_ + 9)) + 1;
+
+  if (!vol_->allocContiguous(count, &curCluster_, count << 4)) return false;
+
+  // if first cluster of file link to directory entry
+  if (firstCluster_ == 0) {
+    firstCluster_ = curCluster_;
+    flags_ |= F_FILE_DIR_DIRTY;
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+/** Reserve the first cluster run for an empty file which is about to be
+ * written as stream.
+ *
+ * The run is recorded in the directory entry while the file size stays
+ * zero, so that releaseUnused() can free it after an interrupted upload.
+ * write() fills the run without allocating clusters and reserves the next
+ * run at its end.  Call releaseUnused() when the file is complete.
+ *
+ * \return The value one, true, is returned for success and
+ * the value zero, false, is returned for failure.
+ * Reasons for failure include the file is not empty or not open for
+ * write, no free run of clusters nearby or an I/O error.
+ */
+bool SdBaseFile::preallocate() {
+  if (!isFile() || !(flags_ & O_WRITE) || firstCluster_ != 0) {
+    DBG_FAIL_MACRO;
+    goto fail;
+  }
+  if (!addClusterRun()) {
+    DBG_FAIL_MACRO;
+    goto fail;
+  }
+  // write() starts at the first cluster
+  curCluster_ = 0;
+
+  return sync();
+
+ fail:
+  return false;
+}
+//------------------------------------------------------------------------------
+/** Free the clusters behind the end of a file, like the rest of the
+ * cluster run which has been reserved for a file written as stream.
+ *
+ * \return The value one, true, is returned for success and
+ * the value zero, false, is returned for failure.
+ * Reasons for failure include the file is not open for write or an
+ * I/O error.
+ */
+bool SdBaseFile::releaseUnused() {
+  if (!isFile() || !(flags_ & O_WRITE)) {
+    DBG_FAIL_MACRO;
+    goto fail;
+  }
+  if (fileSize_ != 0) return truncate(fileSize_);
+
+  // an empty file does not need any cluster
+  if (firstCluster_ == 0) return true;
+  if (!vol_->freeChain(firstCluster_)) {
+    DBG_FAIL_MACRO;
+    goto fail;
+  }
+  firstCluster_ = 0;
+  curCluster_ = 0;
+  curPosition_ = 0;
+
+  // insure sync() will update dir entry
+  flags_ |= F_FILE_DIR_DIRTY;
+
+  return sync();
+
+ fail:
+  return false;
+}
+#endif  // FEATURE_SD_FAST_UPLOAD
 //------------------------------------------------------------------------------
 /** Return a file's directory entry.
  *
@@ -1087,6 +1187,18 @@ bool SdBaseFile::open(SdBaseFile* dirFile, const char* path, uint8_t oflag)
     {
     if (*dname == 0)
       return true;
+#if FEATURE_SD_NAME_INDEX
+    // only the last directory of the path is indexed
+    if (!(oflag & O_CREAT)) {
+      int8_t found = parent.nameIndexFind((const char*)dname);
+      if (found == 0 || (found > 0 && (oflag & O_EXCL)))
+        return false;
+      if (found > 0) {
+        vol_ = parent.vol_;
+        return openCachedEntry(0XF & ((parent.curPosition_-31) >> 5), oflag);
+      }
+    }
+#endif  // FEATURE_SD_NAME_INDEX
     return open(&parent, dname, oflag, false);
     }
 
@@ -1105,6 +1217,81 @@ uint8_t SdBaseFile::lfn_checksum(const uint8_t *pFCBName)
 
    return sum;
 }
+#if FEATURE_SD_NAME_INDEX
+//------------------------------------------------------------------------------
+// case insensitive hash of a long filename
+uint16_t SdBaseFile::nameHash(const char* name) {
+  uint16_t hash = 0;
+  while (*name) hash = hash * 31 + (uint8_t)tolower(*name++);
+  return hash;
+}
+//------------------------------------------------------------------------------
+// index the names of this directory, slots are probed linearly
+void SdBaseFile::nameIndexBuild() {
+  uint16_t count = 0;
+  uint32_t pos;
+
+  memset(nameIndexPos_, 0XFF, sizeof(nameIndexPos_));
+  nameIndexCluster_ = firstCluster_;
+  nameIndexComplete_ = true;
+  nameIndexValid_ = true;
+
+  rewind();
+  for (pos = 0; getLongFilename(NULL, tempLongFilename, 0, NULL);
+       pos = curPosition_) {
+    // keep a free slot, so that a search for a missing name ends
+    if (count >= SD_NAME_INDEX_SIZE - 1 || (pos >> 5) >= 0XFFFF) {
+      nameIndexComplete_ = false;
+      nameIndexEnd_ = pos >> 5;
+      break;
+    }
+    uint16_t hash = nameHash(tempLongFilename);
+    uint8_t slot = hash % SD_NAME_INDEX_SIZE;
+    while (nameIndexPos_[slot] != 0XFFFF) {
+      if (++slot >= SD_NAME_INDEX_SIZE) slot = 0;
+    }
+    // the entries of the name start behind the previous name
+    nameIndexPos_[slot] = pos >> 5;
+    nameIndexTag_[slot] = hash >> 8;
+    count++;
+  }
+}
+//------------------------------------------------------------------------------
+/** Find a name in this directory with the help of the name index.
+ *
+ * \return 1 if the name was found, the directory is positioned behind its
+ * entry and the entry is in the cache like after getLongFilename().
+ * 0 if the directory does not contain the name, -1 if the directory has
+ * to be searched from its beginning.
+ */
+int8_t SdBaseFile::nameIndexFind(const char* name) {
+  uint16_t hash = nameHash(name);
+  uint8_t slot = hash % SD_NAME_INDEX_SIZE;
+
+  if (!nameIndexValid_ || nameIndexCluster_ != firstCluster_) {
+    nameIndexBuild();
+  }
+  while (nameIndexPos_[slot] != 0XFFFF) {
+    if (nameIndexTag_[slot] == (uint8_t)(hash >> 8)) {
+      // verify the name, different names may share a hash
+      if (!seekSet((uint32_t)nameIndexPos_[slot] << 5)) return -1;
+      if (getLongFilename(NULL, tempLongFilename, 0, NULL)
+          && RFstricmp(tempLongFilename, name) == 0) {
+        return 1;
+      }
+    }
+    if (++slot >= SD_NAME_INDEX_SIZE) slot = 0;
+  }
+  if (nameIndexComplete_) return 0;
+
+  // names behind the indexed ones are compared one by one
+  if (!seekSet((uint32_t)nameIndexEnd_ << 5)) return -1;
+  while (getLongFilename(NULL, tempLongFilename, 0, NULL)) {
+    if (RFstricmp(tempLongFilename, name) == 0) return 1;
+  }
+  return 0;
+}
+#endif  // FEATURE_SD_NAME_INDEX
 //------------------------------------------------------------------------------
 // open with filename in dname
 bool SdBaseFile::open(SdBaseFile* dirFile,const uint8_t *dname, uint8_t oflag, bool bDir) {
@@ -1157,6 +1344,10 @@ bool SdBaseFile::open(SdBaseFile* dirFile,const uint8_t *dname, uint8_t oflag, b
     if (!(oflag & O_CREAT) || !(oflag & O_WRITE)) {
       goto fail;
     }
+#if FEATURE_SD_NAME_INDEX || FEATURE_SD_DIRECTORY_INDEX
+    // the new entries change the directory
+    dirChanged();
+#endif  // FEATURE_SD_NAME_INDEX || FEATURE_SD_DIRECTORY_INDEX
 
       dirFile->findSpace(&tempDir, cVFATNeeded, &cVFATFoundCur, &wIndexPos);
       if (wIndexPos != 0)
@@ -1410,6 +1601,14 @@ bool SdBaseFile::openCachedEntry(uint8_t dirIndex, uint8_t oflag) {
     DBG_FAIL_MACRO;
     goto fail;
   }
+#if FEATURE_SD_FAST_UPLOAD
+  // an empty file with clusters is left by an interrupted upload
+  if ((oflag & O_WRITE) && isFile() && fileSize_ == 0 && firstCluster_ != 0
+      && !releaseUnused()) {
+    DBG_FAIL_MACRO;
+    goto fail;
+  }
+#endif  // FEATURE_SD_FAST_UPLOAD
   return oflag & O_AT_END ? seekEnd(0) : true;
 
  fail:
@@ -1888,6 +2087,11 @@ int SdBaseFile::read(void* buf, size_t nbyte) {
       n = 512 - offset;
       if (n > toRead) n = toRead;
       // read block to cache and copy data to caller
+#if FEATURE_SD_STREAMING_READ
+      if (flags_ & F_STREAM) {
+        pc = vol_->cacheFetch(block, SdVolume::CACHE_STATUS_STREAM);
+      } else
+#endif  // FEATURE_SD_STREAMING_READ
       pc = vol_->cacheFetch(block, SdVolume::CACHE_FOR_READ);
       if (!pc) {
         DBG_FAIL_MACRO;
@@ -2177,6 +2381,9 @@ dir_t* SdBaseFile::readDirCache() {
  */
 bool SdBaseFile::remove() {
   dir_t* d;
+#if FEATURE_SD_NAME_INDEX || FEATURE_SD_DIRECTORY_INDEX
+  dirChanged();
+#endif  // FEATURE_SD_NAME_INDEX || FEATURE_SD_DIRECTORY_INDEX
   // free any clusters - will fail if read-only or directory
   if (!truncate(0)) {
     DBG_FAIL_MACRO;
@@ -2248,6 +2455,9 @@ bool SdBaseFile::rename(SdBaseFile* dirFile, const char* newPath) {
   cache_t* pc;
   dir_t* d;
 
+#if FEATURE_SD_NAME_INDEX || FEATURE_SD_DIRECTORY_INDEX
+  dirChanged();
+#endif  // FEATURE_SD_NAME_INDEX || FEATURE_SD_DIRECTORY_INDEX
   // must be an open file or subdirectory
   if (!(isFile() || isSubDir())) {
     DBG_FAIL_MACRO;
@@ -2478,6 +2688,27 @@ SdBaseFile::SdBaseFile(const char* path, uint8_t oflag) {
   writeError = false;
   open(path, oflag);
 }
+#if FEATURE_TOOLCHANGE_PREHEAT
+//------------------------------------------------------------------------------
+/** Return the block which holds the byte read last, as long as the block
+ * cache of the volume still holds it.  No card command is issued.
+ *
+ * \return A pointer to the 512 bytes of the block or zero if the block is
+ * not in the cache.
+ */
+const uint8_t* SdBaseFile::cachedBlock() {
+  uint32_t pos;
+  uint32_t block;
+  if (!isOpen() || curPosition_ == 0) return 0;
+  pos = curPosition_ - 1;
+  if (type_ == FAT_FILE_TYPE_ROOT_FIXED) {
+    block = vol_->rootDirStart() + (pos >> 9);
+  } else {
+    block = vol_->clusterStartBlock(curCluster_) + vol_->blockOfCluster(pos);
+  }
+  return block == vol_->cacheBlockNumber() ? vol_->cacheAddress()->data : 0;
+}
+#endif  // FEATURE_TOOLCHANGE_PREHEAT
 //------------------------------------------------------------------------------
 /** Sets a file's position.
  *
@@ -2516,12 +2747,31 @@ bool SdBaseFile::seekSet(uint32_t pos) {
     // advance from curPosition
     nNew -= nCur;
   }
+#if FEATURE_SD_EXTENT_CACHE
+  while (nNew) {
+    uint32_t end;
+    if (vol_->extentFind(curCluster_, &end)) {
+      // skip the known part of a run of contiguous clusters at once
+      end -= curCluster_;
+      if (end > nNew) end = nNew;
+      curCluster_ += end;
+      nNew -= end;
+      continue;
+    }
+    if (!vol_->fatGet(curCluster_, &curCluster_)) {
+      DBG_FAIL_MACRO;
+      goto fail;
+    }
+    nNew--;
+  }
+#else  // FEATURE_SD_EXTENT_CACHE
   while (nNew--) {
     if (!vol_->fatGet(curCluster_, &curCluster_)) {
       DBG_FAIL_MACRO;
       goto fail;
     }
   }
+#endif  // FEATURE_SD_EXTENT_CACHE
   curPosition_ = pos;
 
  done:
@@ -2915,6 +3165,9 @@ int SdBaseFile::write(const void* buf, size_t nbyte) {
         // rewrite part of block
         cacheOption = SdVolume::CACHE_FOR_WRITE;
         }
+#if FEATURE_SD_FAST_UPLOAD
+      if (flags_ & F_STREAM) cacheOption |= SdVolume::CACHE_STATUS_STREAM;
+#endif  // FEATURE_SD_FAST_UPLOAD
 #ifdef GLENN_DEBUG
   Com::print("BL:");
   Com::print(block);
@@ -3186,6 +3439,10 @@ static uint16_t CRC_CCITT(const uint8_t* data, size_t n) {
 //------------------------------------------------------------------------------
 // send command and return error code.  Return zero for OK
 uint8_t Sd2Card::cardCommand(uint8_t cmd, uint32_t arg) {
+#if FEATURE_SD_STREAMING_READ || FEATURE_SD_FAST_UPLOAD
+  // any other command ends an open multi-block transfer
+  if (streamCommand_ && cmd != CMD12) streamStop();
+#endif  // FEATURE_SD_STREAMING_READ || FEATURE_SD_FAST_UPLOAD
   // select card
   chipSelectLow();
 
@@ -3330,8 +3587,147 @@ bool Sd2Card::eraseSingleBlockEnable() {
  * the value zero, false, is returned for failure.  The reason for failure
  * can be determined by calling errorCode() and errorData().
  */
+#if FEATURE_SD_NONBLOCKING_MOUNT
+bool Sd2Card::init(uint8_t sckRateID, uint8_t chipSelectPin) {
+  int8_t rc;
+  initStart(sckRateID, chipSelectPin);
+  while ((rc = initStep()) == 0) {}
+  return rc > 0;
+}
+//------------------------------------------------------------------------------
+/**
+ * Start an incremental initialization of an SD flash memory card.
+ * The initialization is done by calling initStep() until it does not
+ * return zero.
+ *
+ * \param[in] sckRateID SPI clock rate selector. See setSckRate().
+ * \param[in] chipSelectPin SD chip select pin number.
+ */
+void Sd2Card::initStart(uint8_t sckRateID, uint8_t chipSelectPin) {
+  errorCode_ = type_ = 0;
+#if FEATURE_SD_STREAMING_READ || FEATURE_SD_FAST_UPLOAD
+  // a new card does not know about a transfer of the previous one
+  streamCommand_ = 0;
+  streamBlock_ = 0;
+#endif  // FEATURE_SD_STREAMING_READ || FEATURE_SD_FAST_UPLOAD
+  chipSelectPin_ = chipSelectPin;
+  initSckRate_ = sckRateID;
+  initState_ = SD_INIT_STATE_CMD0;
+  // 16-bit init start time allows over a minute
+  initTime_ = (uint16_t)HAL::timeInMilliseconds();
+
+  HAL::pinMode(chipSelectPin_, OUTPUT);
+  HAL::digitalWrite(chipSelectPin_, HIGH);
+  spiBegin();
+
+#ifndef SOFTWARE_SPI
+  // set SCK rate for initialization commands
+  spiRate_ = SPI_SD_INIT_RATE;
+  spiInit(spiRate_);
+#endif  // SOFTWARE_SPI
+
+  // must supply min of 74 clock cycles with CS high.
+  for (uint8_t i = 0; i < 10; i++) spiSend(0XFF);
+}
+//------------------------------------------------------------------------------
+/**
+ * Send the next command of an initialization which has been started
+ * by initStart(). Each call sends one command (two for ACMD41), so the
+ * time which the card needs to become ready is spent between the calls.
+ *
+ * \return The value one is returned when the card is ready, zero is
+ * returned while the initialization is in progress and minus one is
+ * returned for failure.  The reason for failure can be determined by
+ * calling errorCode() and errorData().
+ */
+int8_t Sd2Card::initStep() {
+  switch (initState_) {
+    case SD_INIT_STATE_CMD0:
+      // command to go idle in SPI mode
+      if (cardCommand(CMD0, 0) != R1_IDLE_STATE) {
+        if (((uint16_t)HAL::timeInMilliseconds() - initTime_) > SD_INIT_TIMEOUT) {
+          error(SD_CARD_ERROR_CMD0);
+          goto fail;
+        }
+        break;
+      }
+#if USE_SD_CRC
+      if (cardCommand(CMD59, 1) != R1_IDLE_STATE) {
+        error(SD_CARD_ERROR_CMD59);
+        goto fail;
+      }
+#endif  // USE_SD_CRC
+      initState_ = SD_INIT_STATE_CMD8;
+      break;
+
+    case SD_INIT_STATE_CMD8:
+      // check SD version
+      if (cardCommand(CMD8, 0x1AA) == (R1_ILLEGAL_COMMAND | R1_IDLE_STATE)) {
+        type(SD_CARD_TYPE_SD1);
+      } else {
+        for (uint8_t i = 0; i < 4; i++) status_ = spiRec();
+        if (status_ != 0XAA) {
+          if (((uint16_t)HAL::timeInMilliseconds() - initTime_) > SD_INIT_TIMEOUT) {
+            error(SD_CARD_ERROR_CMD8);
+            goto fail;
+          }
+          break;
+        }
+        type(SD_CARD_TYPE_SD2);
+      }
+      initState_ = SD_INIT_STATE_ACMD41;
+      break;
+
+    case SD_INIT_STATE_ACMD41:
+      // initialize card and send host supports SDHC if SD2
+      if (cardAcmd(ACMD41, type() == SD_CARD_TYPE_SD2 ? 0X40000000 : 0)
+        != R1_READY_STATE) {
+        // check for timeout
+        if (((uint16_t)HAL::timeInMilliseconds() - initTime_) > SD_INIT_TIMEOUT) {
+          error(SD_CARD_ERROR_ACMD41);
+          goto fail;
+        }
+        break;
+      }
+      // if SD2 read OCR register to check for SDHC card
+      if (type() == SD_CARD_TYPE_SD2) {
+        if (cardCommand(CMD58, 0)) {
+          error(SD_CARD_ERROR_CMD58);
+          goto fail;
+        }
+        if ((spiRec() & 0XC0) == 0XC0) type(SD_CARD_TYPE_SDHC);
+        // discard rest of ocr - contains allowed voltage range
+        for (uint8_t i = 0; i < 3; i++) spiRec();
+      }
+      chipSelectHigh();
+      initState_ = SD_INIT_STATE_DONE;
+
+#ifndef SOFTWARE_SPI
+      return setSckRate(initSckRate_) ? 1 : -1;
+#else  // SOFTWARE_SPI
+      return 1;
+#endif  // SOFTWARE_SPI
+
+    default:
+      // the initialization has ended or has not been started
+      return errorCode_ ? -1 : 1;
+  }
+  chipSelectHigh();
+  return 0;
+
+ fail:
+  initState_ = SD_INIT_STATE_DONE;
+  chipSelectHigh();
+  return -1;
+}
+#else  // FEATURE_SD_NONBLOCKING_MOUNT
 bool Sd2Card::init(uint8_t sckRateID, uint8_t chipSelectPin) {
   errorCode_ = type_ = 0;
+#if FEATURE_SD_STREAMING_READ || FEATURE_SD_FAST_UPLOAD
+  // a new card does not know about a transfer of the previous one
+  streamCommand_ = 0;
+  streamBlock_ = 0;
+#endif  // FEATURE_SD_STREAMING_READ || FEATURE_SD_FAST_UPLOAD
   chipSelectPin_ = chipSelectPin;
   // 16-bit init start time allows over a minute
   uint16_t t0 = (uint16_t)HAL::timeInMilliseconds();
@@ -3411,6 +3807,7 @@ bool Sd2Card::init(uint8_t sckRateID, uint8_t chipSelectPin) {
   chipSelectHigh();
   return false;
 }
+#endif  // FEATURE_SD_NONBLOCKING_MOUNT
 //------------------------------------------------------------------------------
 /**
  * Read a 512 byte block from an SD card.
@@ -3435,6 +3832,59 @@ bool Sd2Card::readBlock(uint32_t blockNumber, uint8_t* dst) {
   chipSelectHigh();
   return false;
 }
+#if FEATURE_SD_STREAMING_READ
+//------------------------------------------------------------------------------
+/**
+ * Read a 512 byte block of a file which is read sequentially.
+ *
+ * A block which follows the previous one is taken from an open CMD18
+ * transfer, which is started when needed.  Any other block is read with
+ * readBlock(), so a seek costs one single-block read.  Any other card
+ * command ends the transfer.
+ *
+ * \param[in] blockNumber Logical block to be read.
+ * \param[out] dst Pointer to the location that will receive the data.
+ *
+ * \return The value one, true, is returned for success and
+ * the value zero, false, is returned for failure.
+ */
+bool Sd2Card::readBlockStream(uint32_t blockNumber, uint8_t* dst) {
+  if (blockNumber != streamBlock_) {
+    streamBlock_ = blockNumber + 1;
+    return readBlock(blockNumber, dst);
+  }
+  if (streamCommand_ != CMD18) {
+    if (!readStart(blockNumber)) goto fail;
+    streamCommand_ = CMD18;
+  }
+  if (!readData(dst)) {
+    streamStop();
+    goto fail;
+  }
+  streamBlock_ = blockNumber + 1;
+  return true;
+
+ fail:
+  streamBlock_ = 0;
+  return false;
+}
+#endif  // FEATURE_SD_STREAMING_READ
+#if FEATURE_SD_STREAMING_READ || FEATURE_SD_FAST_UPLOAD
+//------------------------------------------------------------------------------
+/** End the multi-block transfer of readBlockStream() or writeBlockStream()
+ * if one is open.
+ *
+ * \return The value one, true, is returned for success and
+ * the value zero, false, is returned for failure.
+ */
+bool Sd2Card::streamStop() {
+  uint8_t cmd = streamCommand_;
+  streamCommand_ = 0;
+  if (cmd == CMD18) return readStop();
+  if (cmd == CMD25) return writeStop();
+  return true;
+}
+#endif  // FEATURE_SD_STREAMING_READ || FEATURE_SD_FAST_UPLOAD
 //------------------------------------------------------------------------------
 /** Read one data block in a multiple block read sequence
  *
@@ -3615,6 +4065,43 @@ bool Sd2Card::writeBlock(uint32_t blockNumber, const uint8_t* src) {
   chipSelectHigh();
   return false;
 }
+#if FEATURE_SD_FAST_UPLOAD
+//------------------------------------------------------------------------------
+/**
+ * Write a 512 byte block of a file which is written sequentially.
+ *
+ * A block which follows the previous one is sent within an open CMD25
+ * transfer, so the card programs it while the next block is collected.
+ * Any other block is written with writeBlock().  Any other card command
+ * ends the transfer.
+ *
+ * \param[in] blockNumber Logical block to be written.
+ * \param[in] src Pointer to the location of the data to be written.
+ *
+ * \return The value one, true, is returned for success and
+ * the value zero, false, is returned for failure.
+ */
+bool Sd2Card::writeBlockStream(uint32_t blockNumber, const uint8_t* src) {
+  if (blockNumber != streamBlock_) {
+    streamBlock_ = blockNumber + 1;
+    return writeBlock(blockNumber, src);
+  }
+  if (streamCommand_ != CMD25) {
+    if (!writeStart(blockNumber, 1)) goto fail;
+    streamCommand_ = CMD25;
+  }
+  if (!writeData(src)) {
+    streamStop();
+    goto fail;
+  }
+  streamBlock_ = blockNumber + 1;
+  return true;
+
+ fail:
+  streamBlock_ = 0;
+  return false;
+}
+#endif  // FEATURE_SD_FAST_UPLOAD
 //------------------------------------------------------------------------------
 /** Write one data block in a multiple block write sequence
  * \param[in] src Pointer to the location of the data to be written.
@@ -3730,7 +4217,13 @@ Sd2Card* SdVolume::sdCard_;            // pointer to SD card object
 #endif  // USE_MULTIPLE_CARDS
 //------------------------------------------------------------------------------
 // find a contiguous group of clusters
+#if FEATURE_SD_FAST_UPLOAD
+// searchLimit bounds the number of checked clusters, zero checks all
+bool SdVolume::allocContiguous(uint32_t count, uint32_t* curCluster,
+                               uint32_t searchLimit) {
+#else  // FEATURE_SD_FAST_UPLOAD
 bool SdVolume::allocContiguous(uint32_t count, uint32_t* curCluster) {
+#endif  // FEATURE_SD_FAST_UPLOAD
   // start of group
   uint32_t bgnCluster;
   // end of group
@@ -3765,6 +4258,9 @@ bool SdVolume::allocContiguous(uint32_t count, uint32_t* curCluster) {
       DBG_FAIL_MACRO;
       goto fail;
     }
+#if FEATURE_SD_FAST_UPLOAD
+    if (searchLimit && n >= searchLimit) goto fail;
+#endif  // FEATURE_SD_FAST_UPLOAD
 
     // past end - start from beginning of FAT
     if (endCluster > fatEnd) {
@@ -3837,6 +4333,14 @@ cache_t* SdVolume::cacheFetchData(uint32_t blockNumber, uint8_t options) {
       Com::print(blockNumber);
       Com::println();
 #endif
+#if FEATURE_SD_STREAMING_READ
+      if (options & CACHE_STATUS_STREAM) {
+        if (!sdCard_->readBlockStream(blockNumber, cacheBuffer_.data)) {
+          DBG_FAIL_MACRO;
+          goto fail;
+        }
+      } else
+#endif  // FEATURE_SD_STREAMING_READ
       if (!sdCard_->readBlock(blockNumber, cacheBuffer_.data)) {
         DBG_FAIL_MACRO;
         goto fail;
@@ -3880,6 +4384,14 @@ bool SdVolume::cacheSync() {
 //------------------------------------------------------------------------------
 bool SdVolume::cacheWriteData() {
   if (cacheStatus_ & CACHE_STATUS_DIRTY) {
+#if FEATURE_SD_FAST_UPLOAD
+    if (cacheStatus_ & CACHE_STATUS_STREAM) {
+      if (!sdCard_->writeBlockStream(cacheBlockNumber_, cacheBuffer_.data)) {
+        DBG_FAIL_MACRO;
+        goto fail;
+      }
+    } else
+#endif  // FEATURE_SD_FAST_UPLOAD
     if (!sdCard_->writeBlock(cacheBlockNumber_, cacheBuffer_.data)) {
       DBG_FAIL_MACRO;
       goto fail;
@@ -3922,6 +4434,14 @@ cache_t* SdVolume::cacheFetch(uint32_t blockNumber, uint8_t options) {
       goto fail;
     }
     if (!(options & CACHE_OPTION_NO_READ)) {
+#if FEATURE_SD_STREAMING_READ
+      if (options & CACHE_STATUS_STREAM) {
+        if (!sdCard_->readBlockStream(blockNumber, cacheBuffer_.data)) {
+          DBG_FAIL_MACRO;
+          goto fail;
+        }
+      } else
+#endif  // FEATURE_SD_STREAMING_READ
       if (!sdCard_->readBlock(blockNumber, cacheBuffer_.data)) {
         DBG_FAIL_MACRO;
         goto fail;
@@ -3948,6 +4468,14 @@ bool SdVolume::cacheSync() {
     Com::print(cacheBlockNumber_);
     Com::println();
 #endif
+#if FEATURE_SD_FAST_UPLOAD
+    if (cacheStatus_ & CACHE_STATUS_STREAM) {
+      if (!sdCard_->writeBlockStream(cacheBlockNumber_, cacheBuffer_.data)) {
+        DBG_FAIL_MACRO;
+        goto fail;
+      }
+    } else
+#endif  // FEATURE_SD_FAST_UPLOAD
     if (!sdCard_->writeBlock(cacheBlockNumber_, cacheBuffer_.data)) {
       DBG_FAIL_MACRO;
       goto fail;
@@ -3997,6 +4525,13 @@ bool SdVolume::fatGet(uint32_t cluster, uint32_t* value) {
     goto fail;
 
   }
+#if FEATURE_SD_EXTENT_CACHE
+  // no FAT read within a known run of contiguous clusters
+  if (extentFind(cluster, &lba)) {
+    *value = cluster + 1;
+    return true;
+  }
+#endif  // FEATURE_SD_EXTENT_CACHE
 
   if (FAT12_SUPPORT && fatType_ == 12) {
 
@@ -4043,11 +4578,63 @@ bool SdVolume::fatGet(uint32_t cluster, uint32_t* value) {
   } else {
     *value = pc->fat32[cluster & 0X7F] & FAT32MASK;
   }
+#if FEATURE_SD_EXTENT_CACHE
+  if (*value == cluster + 1) extentLearn(cluster, pc);
+#endif  // FEATURE_SD_EXTENT_CACHE
   return true;
 
  fail:
   return false;
 }
+#if FEATURE_SD_EXTENT_CACHE
+//------------------------------------------------------------------------------
+// forget all runs of contiguous clusters
+void SdVolume::extentClear() {
+  for (uint8_t i = 0; i < SD_EXTENT_CACHE_SIZE; i++) {
+    extentEnd_[i] = 0;
+  }
+  extentReplace_ = 0;
+}
+//------------------------------------------------------------------------------
+// check whether the successor of cluster is cluster + 1, end receives the
+// last cluster of the run
+bool SdVolume::extentFind(uint32_t cluster, uint32_t* end) {
+  for (uint8_t i = 0; i < SD_EXTENT_CACHE_SIZE; i++) {
+    if (extentStart_[i] <= cluster && cluster < extentEnd_[i]) {
+      *end = extentEnd_[i];
+      return true;
+    }
+  }
+  return false;
+}
+//------------------------------------------------------------------------------
+// collect the run of contiguous clusters which starts at cluster from the
+// FAT block in pc, the FAT entry of cluster is cluster + 1
+void SdVolume::extentLearn(uint32_t cluster, cache_t* pc) {
+  uint32_t end = cluster + 1;
+  uint16_t mask = fatType_ == 16 ? 0XFF : 0X7F;
+  uint16_t index = (cluster & mask) + 1;
+
+  // follow the run until the end of this FAT block
+  while (index <= mask) {
+    uint32_t next = fatType_ == 16 ? pc->fat16[index]
+                                   : pc->fat32[index] & FAT32MASK;
+    if (next != end + 1) break;
+    end++;
+    index++;
+  }
+  // extend the run which ends at cluster, if there is one
+  for (uint8_t i = 0; i < SD_EXTENT_CACHE_SIZE; i++) {
+    if (extentEnd_[i] == cluster) {
+      extentEnd_[i] = end;
+      return;
+    }
+  }
+  extentStart_[extentReplace_] = cluster;
+  extentEnd_[extentReplace_] = end;
+  if (++extentReplace_ >= SD_EXTENT_CACHE_SIZE) extentReplace_ = 0;
+}
+#endif  // FEATURE_SD_EXTENT_CACHE
 //------------------------------------------------------------------------------
 // Store a FAT entry
 bool SdVolume::fatPut(uint32_t cluster, uint32_t value) {
@@ -4058,6 +4645,14 @@ bool SdVolume::fatPut(uint32_t cluster, uint32_t value) {
     DBG_FAIL_MACRO;
     goto fail;
   }
+#if FEATURE_SD_EXTENT_CACHE
+  // a run of contiguous clusters ends at a changed FAT entry
+  for (uint8_t i = 0; i < SD_EXTENT_CACHE_SIZE; i++) {
+    if (extentStart_[i] <= cluster && cluster < extentEnd_[i]) {
+      extentEnd_[i] = cluster > extentStart_[i] ? cluster : 0;
+    }
+  }
+#endif  // FEATURE_SD_EXTENT_CACHE
   if (FAT12_SUPPORT && fatType_ == 12) {
     uint16_t index = cluster;
     index += index >> 1;
@@ -4216,6 +4811,12 @@ bool SdVolume::init(Sd2Card* dev, uint8_t part) {
   sdCard_ = dev;
   fatType_ = 0;
   allocSearchStart_ = 2;
+#if FEATURE_SD_EXTENT_CACHE
+  extentClear();
+#endif  // FEATURE_SD_EXTENT_CACHE
+#if FEATURE_SD_NAME_INDEX || FEATURE_SD_DIRECTORY_INDEX
+  SdBaseFile::dirChanged();
+#endif  // FEATURE_SD_NAME_INDEX || FEATURE_SD_DIRECTORY_INDEX
   cacheStatus_ = 0;  // cacheSync() will write block if true
   cacheBlockNumber_ = 0XFFFFFFFF;
   cacheFatOffset_ = 0;
@@ -702,6 +702,18 @@ uint16_t const SD_ERASE_TIMEOUT = 10000;
 uint16_t const SD_READ_TIMEOUT = 300;
 /** write time out ms */
 uint16_t const SD_WRITE_TIMEOUT = 600;
+#if FEATURE_SD_NONBLOCKING_MOUNT
+//------------------------------------------------------------------------------
+// steps of an incremental card initialization, see Sd2Card::initStep()
+/** the next step sends CMD0 (go idle in SPI mode) */
+uint8_t const SD_INIT_STATE_CMD0 = 0;
+/** the next step sends CMD8 (check the SD version) */
+uint8_t const SD_INIT_STATE_CMD8 = 1;
+/** the next step sends ACMD41 (wait until the card is ready) */
+uint8_t const SD_INIT_STATE_ACMD41 = 2;
+/** the initialization has ended */
+uint8_t const SD_INIT_STATE_DONE = 3;
+#endif  // FEATURE_SD_NONBLOCKING_MOUNT
 //------------------------------------------------------------------------------
 // SD card errors
 /** timeout error for command CMD0 (initialize card in SPI mode) */
@@ -798,7 +810,12 @@ uint8_t const SD_CHIP_SELECT_PIN = SOFT_SPI_CS_PIN;
 class Sd2Card {
  public:
   /** Construct an instance of Sd2Card. */
+#if FEATURE_SD_NONBLOCKING_MOUNT
+  Sd2Card() : errorCode_(SD_CARD_ERROR_INIT_NOT_CALLED), type_(0),
+    initState_(SD_INIT_STATE_DONE) {}
+#else  // FEATURE_SD_NONBLOCKING_MOUNT
   Sd2Card() : errorCode_(SD_CARD_ERROR_INIT_NOT_CALLED), type_(0) {}
+#endif  // FEATURE_SD_NONBLOCKING_MOUNT
   uint32_t cardSize();
   bool erase(uint32_t firstBlock, uint32_t lastBlock);
   bool eraseSingleBlockEnable();
@@ -821,7 +838,18 @@ class Sd2Card {
    */
   bool init(uint8_t sckRateID = SPI_FULL_SPEED,
     uint8_t chipSelectPin = SD_CHIP_SELECT_PIN);
+#if FEATURE_SD_NONBLOCKING_MOUNT
+  void initStart(uint8_t sckRateID = SPI_FULL_SPEED,
+    uint8_t chipSelectPin = SD_CHIP_SELECT_PIN);
+  int8_t initStep();
+#endif  // FEATURE_SD_NONBLOCKING_MOUNT
   bool readBlock(uint32_t block, uint8_t* dst);
+#if FEATURE_SD_STREAMING_READ
+  bool readBlockStream(uint32_t block, uint8_t* dst);
+#endif  // FEATURE_SD_STREAMING_READ
+#if FEATURE_SD_STREAMING_READ || FEATURE_SD_FAST_UPLOAD
+  bool streamStop();
+#endif  // FEATURE_SD_STREAMING_READ || FEATURE_SD_FAST_UPLOAD
   /**
    * Read a card's CID register. The CID contains card identification
    * information such as Manufacturer ID, Product name, Product serial
@@ -854,6 +882,9 @@ class Sd2Card {
    */
   int type() const {return type_;}
   bool writeBlock(uint32_t blockNumber, const uint8_t* src);
+#if FEATURE_SD_FAST_UPLOAD
+  bool writeBlockStream(uint32_t blockNumber, const uint8_t* src);
+#endif  // FEATURE_SD_FAST_UPLOAD
   bool writeData(const uint8_t* src);
   bool writeStart(uint32_t blockNumber, uint32_t eraseCount);
   bool writeStop();
@@ -865,6 +896,15 @@ class Sd2Card {
   uint8_t spiRate_;
   uint8_t status_;
   uint8_t type_;
+#if FEATURE_SD_NONBLOCKING_MOUNT
+  uint8_t initState_;      // next SD_INIT_STATE_* step of initStep()
+  uint8_t initSckRate_;    // SCK rate which is set at the end of the init
+  uint16_t initTime_;      // 16-bit start time of the init
+#endif  // FEATURE_SD_NONBLOCKING_MOUNT
+#if FEATURE_SD_STREAMING_READ || FEATURE_SD_FAST_UPLOAD
+  uint8_t streamCommand_;  // CMD18 or CMD25 while a transfer is open at streamBlock_, else 0
+  uint32_t streamBlock_;   // block which follows the last block of the stream
+#endif  // FEATURE_SD_STREAMING_READ || FEATURE_SD_FAST_UPLOAD
   // private functions
   uint8_t cardAcmd(uint8_t cmd, uint32_t arg) {
     cardCommand(CMD55, 0);
@@ -1597,14 +1637,26 @@ class SdVolume {
   uint8_t fatType_;             // volume type (12, 16, OR 32)
   uint16_t rootDirEntryCount_;  // number of entries in FAT16 root dir
   uint32_t rootDirStart_;       // root start block for FAT16, cluster for FAT32
+#if FEATURE_SD_EXTENT_CACHE
+  uint32_t extentStart_[SD_EXTENT_CACHE_SIZE];  // first cluster of a run of contiguous clusters
+  uint32_t extentEnd_[SD_EXTENT_CACHE_SIZE];    // last cluster of the run, 0 = slot unused
+  uint8_t extentReplace_;                       // slot which is replaced next
+#endif  // FEATURE_SD_EXTENT_CACHE
 //------------------------------------------------------------------------------
 // block caches
 // use of static functions save a bit of flash - maybe not worth complexity
 //
   static const uint8_t CACHE_STATUS_DIRTY = 1;
   static const uint8_t CACHE_STATUS_FAT_BLOCK = 2;
+#if FEATURE_SD_STREAMING_READ || FEATURE_SD_FAST_UPLOAD
+  // read and write the block via Sd2Card::readBlockStream()/writeBlockStream()
+  static const uint8_t CACHE_STATUS_STREAM = 8;
+  static const uint8_t CACHE_STATUS_MASK
+     = CACHE_STATUS_DIRTY | CACHE_STATUS_FAT_BLOCK | CACHE_STATUS_STREAM;
+#else  // FEATURE_SD_STREAMING_READ || FEATURE_SD_FAST_UPLOAD
   static const uint8_t CACHE_STATUS_MASK
      = CACHE_STATUS_DIRTY | CACHE_STATUS_FAT_BLOCK;
+#endif  // FEATURE_SD_STREAMING_READ || FEATURE_SD_FAST_UPLOAD
   static const uint8_t CACHE_OPTION_NO_READ = 4;
   // value for option argument in cacheFetch to indicate read from cache
   static uint8_t const CACHE_FOR_READ = 0;
@@ -1657,12 +1709,22 @@ class SdVolume {
   static bool cacheWriteFat();
 #endif  // USE_MULTIPLE_CARDS
 //------------------------------------------------------------------------------
+#if FEATURE_SD_FAST_UPLOAD
+  bool allocContiguous(uint32_t count, uint32_t* curCluster,
+                       uint32_t searchLimit = 0);
+#else  // FEATURE_SD_FAST_UPLOAD
   bool allocContiguous(uint32_t count, uint32_t* curCluster);
+#endif  // FEATURE_SD_FAST_UPLOAD
   uint8_t blockOfCluster(uint32_t position) const {
           return (position >> 9) & (blocksPerCluster_ - 1);}
   uint32_t clusterStartBlock(uint32_t cluster) const;
   bool fatGet(uint32_t cluster, uint32_t* value);
   bool fatPut(uint32_t cluster, uint32_t value);
+#if FEATURE_SD_EXTENT_CACHE
+  void extentClear();
+  bool extentFind(uint32_t cluster, uint32_t* end);
+  void extentLearn(uint32_t cluster, cache_t* pc);
+#endif  // FEATURE_SD_EXTENT_CACHE
   bool fatPutEOC(uint32_t cluster) {
     return fatPut(cluster, 0x0FFFFFFF);
   }
@@ -1961,6 +2023,9 @@ class SdBaseFile {
   bool openRoot(SdVolume* vol);
   int8_t readDir(dir_t& dir, char *longfilename) {return readDir(&dir, longfilename);}
   int peek();
+#if FEATURE_TOOLCHANGE_PREHEAT
+  const uint8_t* cachedBlock();
+#endif  // FEATURE_TOOLCHANGE_PREHEAT
   bool printCreateDateTime();
   static void printFatDate(uint16_t fatDate);
   static void printFatTime(uint16_t fatTime);
@@ -1996,6 +2061,41 @@ class SdBaseFile {
    */
   bool seekEnd(int32_t offset = 0) {return seekSet(fileSize_ + offset);}
   bool seekSet(uint32_t pos);
+#if FEATURE_SD_STREAMING_READ || FEATURE_SD_FAST_UPLOAD
+  /** Read or write the blocks of the file via a multi-block transfer as long
+   * as they are accessed one after another.
+   * \param[in] on true to stream, false for single-block transfers.
+   */
+  void setStreaming(bool on) {
+    if (on) {
+      flags_ |= F_STREAM;
+    } else {
+      flags_ &= ~F_STREAM;
+    }
+  }
+#endif  // FEATURE_SD_STREAMING_READ || FEATURE_SD_FAST_UPLOAD
+#if FEATURE_SD_FAST_UPLOAD
+  bool preallocate();
+  bool releaseUnused();
+#endif  // FEATURE_SD_FAST_UPLOAD
+#if FEATURE_SD_NAME_INDEX || FEATURE_SD_DIRECTORY_INDEX
+  /** Called whenever an entry of a directory is created, removed or renamed
+   * and for a new volume.  The name index is built again by the next lookup,
+   * other indexes of a directory compare dirChangeCount().
+   */
+  static void dirChanged() {
+#if FEATURE_SD_NAME_INDEX
+    nameIndexValid_ = false;
+#endif  // FEATURE_SD_NAME_INDEX
+#if FEATURE_SD_DIRECTORY_INDEX
+    dirChangeCount_++;
+#endif  // FEATURE_SD_DIRECTORY_INDEX
+  }
+#endif  // FEATURE_SD_NAME_INDEX || FEATURE_SD_DIRECTORY_INDEX
+#if FEATURE_SD_DIRECTORY_INDEX
+  /** \return The number of calls of dirChanged(), modulo 256. */
+  static uint8_t dirChangeCount() {return dirChangeCount_;}
+#endif  // FEATURE_SD_DIRECTORY_INDEX
   bool sync();
   bool timestamp(SdBaseFile* file);
   bool timestamp(uint8_t flag, uint16_t year, uint8_t month, uint8_t day,
@@ -2021,6 +2121,10 @@ class SdBaseFile {
   // bits defined in flags_
   // should be 0X0F
   static uint8_t const F_OFLAG = (O_ACCMODE | O_APPEND | O_SYNC);
+#if FEATURE_SD_STREAMING_READ || FEATURE_SD_FAST_UPLOAD
+  // transfer sequential blocks via a multi-block command
+  static uint8_t const F_STREAM = 0X40;
+#endif  // FEATURE_SD_STREAMING_READ || FEATURE_SD_FAST_UPLOAD
   // sync of directory entry required
   static uint8_t const F_FILE_DIR_DIRTY = 0X80;
 
@@ -2037,12 +2141,28 @@ class SdBaseFile {
   uint32_t  firstCluster_;  // first cluster of file
   char *pathend;
 
+#if FEATURE_SD_NAME_INDEX
+  // hash index of the names in the directory which has been searched last
+  static uint16_t nameIndexPos_[SD_NAME_INDEX_SIZE];  // first entry of the name, 0XFFFF = free slot
+  static uint8_t nameIndexTag_[SD_NAME_INDEX_SIZE];   // high byte of the hash of the name
+  static uint32_t nameIndexCluster_;  // first cluster of the indexed directory
+  static uint16_t nameIndexEnd_;      // first entry behind the indexed names
+  static bool nameIndexValid_;
+  static bool nameIndexComplete_;     // all names of the directory are indexed
+#endif  // FEATURE_SD_NAME_INDEX
+#if FEATURE_SD_DIRECTORY_INDEX
+  static uint8_t dirChangeCount_;     // see dirChanged()
+#endif  // FEATURE_SD_DIRECTORY_INDEX
+
 
 
   /** experimental don't use */
   bool openParent(SdBaseFile* dir);
   // private functions
   bool addCluster();
+#if FEATURE_SD_FAST_UPLOAD
+  bool addClusterRun();
+#endif  // FEATURE_SD_FAST_UPLOAD
   cache_t* addDirCluster();
   dir_t* cacheDirEntry(uint8_t action);
   int8_t lsPrintNext(uint8_t flags, uint8_t indent);
@@ -2054,6 +2174,11 @@ class SdBaseFile {
   dir_t* readDirCacheSpecial();
   dir_t *getLongFilename(dir_t *dir, char *longFilename, int8_t cVFATNeeded, uint32_t *pwIndexPos);
   bool findSpace(dir_t *dir, int8_t cVFATNeeded, int8_t *pcVFATFound, uint32_t *pwIndexPos);
+#if FEATURE_SD_NAME_INDEX
+  static uint16_t nameHash(const char* name);
+  void nameIndexBuild();
+  int8_t nameIndexFind(const char* name);
+#endif  // FEATURE_SD_NAME_INDEX
   uint8_t lsRecursive(SdBaseFile *parent, uint8_t level, char *findFilename, SdBaseFile *pParentFound);
 
   bool setDirSize();
@@ -40,6 +40,11 @@ millis_t GCode::timeOfLastDataPacket=0; ///< Time, when we got the last data pac
 uint8_t  GCode::formatErrors=0;
 millis_t GCode::lastBusySignal = 0; ///< When was the last busy signal
 uint32_t GCode::keepAliveInterval = KEEP_ALIVE_INTERVAL;
+#if FEATURE_BAUDRATE_SWITCHING
+uint32_t GCode::serialCommandsReceived = 0;
+uint32_t GCode::serialChecksumErrors = 0;
+uint32_t GCode::serialResendRequests = 0;
+#endif // FEATURE_BAUDRATE_SWITCHING
 
 /** \page Repetier-protocol
 
@@ -160,6 +165,9 @@ void GCode::keepAlive( enum FirmwareState state )
 
 void GCode::requestResend()
 {
+#if FEATURE_BAUDRATE_SWITCHING
+    serialResendRequests ++;
+#endif // FEATURE_BAUDRATE_SWITCHING
     HAL::serialFlush();
     commandsReceivingWritePosition=0;
     if(sendAsBinary)
@@ -240,6 +248,9 @@ void GCode::checkAndPushCommand()
 #endif // ACK_WITH_LINENUMBER
 
     wasLastCommandReceivedAsBinary = sendAsBinary;
+#if FEATURE_BAUDRATE_SWITCHING
+    serialCommandsReceived ++;
+#endif // FEATURE_BAUDRATE_SWITCHING
     keepAlive( NotBusy );
     waitingForResend = -1; // everything is ok.
 
@@ -287,8 +298,10 @@ void GCode::echoCommand()
 {
     if(Printer::debugEcho())
     {
+        Com::beginLowPriority();
         Com::printF(Com::tEcho);
         printCommand();
+        Com::endLowPriority();
     }
 
 } // echoCommand
@@ -407,6 +420,15 @@ void GCode::executeString(char *cmd)
     It must be called frequently to empty the incoming buffer. */
 void GCode::readFromSerial()
 {
+#if SDSUPPORT && FEATURE_SD_BLOCK_UPLOAD
+    if(sd.blockUploadActive)
+    {
+        // the serial data are blocks of a file, not G-Code
+        sd.receiveBlocks();
+        return;
+    }
+#endif // SDSUPPORT && FEATURE_SD_BLOCK_UPLOAD
+
     if(bufferLength>=GCODE_BUFFER_SIZE || (waitUntilAllCommandsAreParsed && bufferLength))
     {
         // all buffers full
@@ -482,6 +504,9 @@ void GCode::readFromSerial()
                 }
                 else
                 {
+#if FEATURE_BAUDRATE_SWITCHING
+                    serialChecksumErrors ++;
+#endif // FEATURE_BAUDRATE_SWITCHING
                     if( GCode::formatErrors < 3 )
                     {
                         requestResend();
@@ -529,6 +554,9 @@ void GCode::readFromSerial()
                 }
                 else
                 {
+#if FEATURE_BAUDRATE_SWITCHING
+                    serialChecksumErrors ++;
+#endif // FEATURE_BAUDRATE_SWITCHING
                     if( GCode::formatErrors < 3 )
                     {
                         requestResend();
@@ -588,6 +616,7 @@ void GCode::readFromSD()
     while( sd.filesize > sd.sdpos && commandsReceivingWritePosition < MAX_CMD_SIZE)    // consume data until no data or buffer full
     {
         timeOfLastDataPacket = HAL::timeInMilliseconds();
+
         int n = sd.file.read();
         if(n==-1)
         {
@@ -595,7 +624,7 @@ void GCode::readFromSD()
                 {
                         Com::printFLN(Com::tSDReadError);
                 }
-                UI_ERROR("SD Read Error");
+                UI_ERROR(UI_TEXT_SD_READ_ERROR);
 
                 // Second try in case of recoverable errors
                 sd.file.seekSet(sd.sdpos);
@@ -612,6 +641,15 @@ void GCode::readFromSD()
             UI_ERROR("SD error fixed");
         }
         sd.sdpos++; // = file.curPosition();
+
+#if FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
+        if( sd.sdpos > sd.toolChangeScanPos )
+        {
+            // the print has entered a block which the look-ahead has not scanned yet, this block is in the cache now
+            sd.toolChangeScanBlock();
+        }
+#endif // FEATURE_TOOLCHANGE_PREHEAT && NUM_EXTRUDER>1
+
         commandReceiving[commandsReceivingWritePosition++] = (uint8_t)n;
 
         // first lets detect, if we got an old type ascii command
@@ -788,7 +826,7 @@ bool GCode::parseBinary(uint8_t *buffer)
             G=*p++;
         }
     }
-    if(hasM() && (M == 23 || M == 28 || M == 29 || M == 30 || M == 32 || M == 117 || M == 3117))
+    if(hasM() && (M == 23 || M == 28 || M == 29 || M == 30 || M == 32 || M == 117 || M == 3117 || M == 3400 || M == 3416))
     {
         if(hasString())   // set text pointer to string
         {
@@ -888,7 +926,7 @@ bool GCode::parseAscii(char *line)
         if(M>255) params |= 4096;
     }
 
-    if(hasM() && (M == 23 || M == 28 || M == 29 || M == 30 || M == 32 || M == 117 || M == 3117))
+    if(hasM() && (M == 23 || M == 28 || M == 29 || M == 30 || M == 32 || M == 117 || M == 3117 || M == 3400 || M == 3416))
     {
         // after M command we got a filename for sd card management
         char *sp = line;
@@ -171,6 +171,20 @@ public:
         return ((params2 & 32768)!=0);
     } // hasFormatError
 
+    inline bool isPlainMove()
+    {
+        // G0/G1 without other parameters than N, X, Y, Z, E and F (bit 128 and 4096 mark the binary V2 format only)
+        return ((params & 4)!=0) && G<=1 && ((params & ~4605)==0) && !params2;
+    } // isPlainMove
+
+    inline bool needsTemperature()
+    {
+        // extrusion and every command which starts a measurement (heat bed scan, z-origin search, work part scan, strain gauge test, z-offset scan) need the heaters at their target temperature
+        if(hasG()) return G<=3 && hasE();
+        if(!hasM()) return false;
+        return M == 3010 || M == 3130 || M == 3150 || M == 3190 || M == 3900 || M == 3901;
+    } // needsTemperature
+
     void printCommand();
     bool parseBinary(uint8_t *buffer);
     bool parseAscii(char *line);
@@ -186,6 +200,11 @@ public:
     static void resetBuffer();
     static void keepAlive(enum FirmwareState state);
     static uint32_t keepAliveInterval;
+#if FEATURE_BAUDRATE_SWITCHING
+    static uint32_t serialCommandsReceived;             ///< Number of commands which have been received via the serial connection successfully.
+    static uint32_t serialChecksumErrors;               ///< Number of commands from the serial connection which could not be parsed because of a wrong checksum or format.
+    static uint32_t serialResendRequests;               ///< Number of resends which have been requested from the host.
+#endif // FEATURE_BAUDRATE_SWITCHING
 
     friend class SDCard;
     friend class UIDisplay;
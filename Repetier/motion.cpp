@@ -1101,6 +1101,31 @@ bool PrintLine::checkForXFreeLines(uint8_t freeLines)
 } // checkForXFreeLines
 
 
+/** \brief Returns the time which is needed to execute all moves of the movement cache in milliseconds. */
+uint32_t PrintLine::queuedTimeInMilliseconds()
+{
+    uint32_t    timeInMilliseconds = 0;
+    uint8_t     pos;
+    uint8_t     count;
+
+
+    {
+        InterruptProtectedBlock noInts;
+        pos   = linesPos;
+        count = linesCount;
+    }
+
+    while( count-- )
+    {
+        // the move which is executed at the moment is counted completely
+        timeInMilliseconds += (uint32_t)lines[pos].timeInTicks / (F_CPU / 1000);
+        nextPlannerIndex(pos);
+    }
+    return timeInMilliseconds;
+
+} // queuedTimeInMilliseconds
+
+
 #if FEATURE_ARC_SUPPORT
 // Arc function taken from grbl
 // The arc is approximated by generating a huge number of tiny, linear segments. The length of each
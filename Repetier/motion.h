@@ -537,6 +537,7 @@ public:
     static long performMove(PrintLine* move, char forQueue);
     static void waitForXFreeLines(uint8_t b=1);
     static bool checkForXFreeLines(uint8_t freeLines=1);
+    static uint32_t queuedTimeInMilliseconds();
     static inline void forwardPlanner(uint8_t p);
     static inline void backwardPlanner(uint8_t p,uint8_t last);
     static void updateTrapezoids();
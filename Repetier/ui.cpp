@@ -147,6 +147,11 @@ bool UIMenuEntry::showEntry() const
 UIDisplay uid;
 char displayCache[UI_ROWS][MAX_COLS+1];
 
+#if FEATURE_DIFFERENTIAL_DISPLAY_UPDATE && UI_DISPLAY_TYPE<4
+// displayCache holds the characters which are shown by the display at the moment
+char displayFrame[UI_ROWS][UI_COLS];    // characters which shall be shown by the display
+#endif // FEATURE_DIFFERENTIAL_DISPLAY_UPDATE && UI_DISPLAY_TYPE<4
+
 // Menu up sign - code 1
 // ..*.. 4
 // .***. 14
@@ -419,6 +424,17 @@ void initializeLCD()
 
     lcdCommand(LCD_CLEAR);                  //- Clear Screen
     HAL::delayMilliseconds(2); // clear is slow operation
+
+#if FEATURE_DIFFERENTIAL_DISPLAY_UPDATE
+    // the display is empty now - everything which differs from that is written again with the next update
+    for(uint8_t r=0; r<UI_ROWS; r++)
+    {
+        memset(displayCache[r],' ',UI_COLS);
+        displayCache[r][UI_COLS] = 0;
+    }
+    uid.displayUpdatePending = true;
+#endif // FEATURE_DIFFERENTIAL_DISPLAY_UPDATE
+
     lcdCommand(LCD_INCREASE | LCD_DISPLAYSHIFTOFF); //- Entrymode (Display Shift: off, Increment Address Counter)
     lcdCommand(LCD_DISPLAYON | LCD_CURSOROFF | LCD_BLINKINGOFF);    //- Display on
     uid.lastSwitch = uid.lastRefresh = HAL::timeInMilliseconds();
@@ -486,6 +502,82 @@ void UIDisplay::printRow(uint8_t r,char *txt,char *txt2,uint8_t changeAtCol)
 #endif // UI_HAS_KEYS==1 && UI_HAS_I2C_ENCODER>0
 
 } // printRow
+
+
+#if FEATURE_DIFFERENTIAL_DISPLAY_UPDATE
+/** \brief Writes the characters of displayFrame which differ from displayCache to the display. Each run of changed characters costs one cursor positioning.
+At most UI_MAX_BYTES_PER_UPDATE bytes are written per call, the remaining characters are written with the next calls of slowAction(). */
+void UIDisplay::updateDisplay()
+{
+    uint8_t bytes     = 0;
+    bool    exhausted = false;
+    uint8_t r;
+    uint8_t col;
+
+
+#if UI_DISPLAY_TYPE==3
+    lcdStartWrite();
+#endif // UI_DISPLAY_TYPE==3
+
+    for(r=0; r<UI_ROWS && !exhausted; r++)
+    {
+        col = 0;
+        while(col<UI_COLS && !exhausted)
+        {
+            if(displayFrame[r][col] == displayCache[r][col])
+            {
+                col++;
+                continue;
+            }
+
+            // position the cursor at the first changed character and write the changed run
+            if(bytes+2 > UI_MAX_BYTES_PER_UPDATE)
+            {
+                exhausted = true;
+                break;
+            }
+            lcdCommand(128 + HAL::readFlashByte((const char *)&LCDLineOffsets[r]) + col);
+            bytes++;
+
+            while(col<UI_COLS && displayFrame[r][col] != displayCache[r][col] && bytes<UI_MAX_BYTES_PER_UPDATE)
+            {
+                lcdPutChar(displayFrame[r][col]);
+                displayCache[r][col] = displayFrame[r][col];
+                bytes++;
+                col++;
+            }
+            if(bytes >= UI_MAX_BYTES_PER_UPDATE)
+            {
+                exhausted = true;
+            }
+        }
+    }
+
+#if UI_DISPLAY_TYPE==3
+    lcdStopWrite();
+#endif // UI_DISPLAY_TYPE==3
+
+#if UI_HAS_KEYS==1 && UI_HAS_I2C_ENCODER>0
+    ui_check_slow_encoder();
+#endif // UI_HAS_KEYS==1 && UI_HAS_I2C_ENCODER>0
+
+    // in case the budget of this call is exhausted, the remaining characters are written with the next call
+    displayUpdatePending = exhausted;
+
+} // updateDisplay
+
+
+/** \brief Stores the row which has been written to the display directly as shown and as wanted, so that the next update does not write it again. */
+void UIDisplay::setShownRow(uint8_t r,const char *txt)
+{
+    for(uint8_t col=0; col<UI_COLS; col++)
+    {
+        displayFrame[r][col] = displayCache[r][col] = (*txt ? *txt++ : ' ');
+    }
+    displayCache[r][UI_COLS] = 0;
+
+} // setShownRow
+#endif // FEATURE_DIFFERENTIAL_DISPLAY_UPDATE
 #endif // UI_DISPLAY_TYPE<4
 
 
@@ -539,6 +631,11 @@ void UIDisplay::initialize()
     folderLevel=0;
 #endif // SDSUPPORT
 
+#if FEATURE_DIFFERENTIAL_DISPLAY_UPDATE && UI_DISPLAY_TYPE<4
+    memset(displayFrame,' ',sizeof(displayFrame));
+    displayUpdatePending = false;
+#endif // FEATURE_DIFFERENTIAL_DISPLAY_UPDATE && UI_DISPLAY_TYPE<4
+
 #if UI_DISPLAY_TYPE>0
     initializeLCD();
 
@@ -572,6 +669,11 @@ void UIDisplay::initialize()
     slideIn(UI_ROWS-1, PSTR(UI_PRINTER_COMPANY));
     strcpy(displayCache[UI_ROWS-1], printCols);
 #endif // UI_ROWS>2
+
+#if FEATURE_DIFFERENTIAL_DISPLAY_UPDATE && UI_DISPLAY_TYPE<4
+    // from now on, displayCache holds the characters which are shown by the display
+    for(uint8_t y=0; y<UI_ROWS; y++) setShownRow(y,displayCache[y]);
+#endif // FEATURE_DIFFERENTIAL_DISPLAY_UPDATE && UI_DISPLAY_TYPE<4
 #endif // UI_ANIMATION==false || UI_DISPLAY_TYPE==5
 
     HAL::delayMilliseconds(UI_START_SCREEN_DELAY);
@@ -628,6 +730,10 @@ void UIDisplay::printRowP(uint8_t r,PGM_P txt)
     printCols[col]=0;
     printRow(r,printCols,NULL,UI_COLS);
 
+#if FEATURE_DIFFERENTIAL_DISPLAY_UPDATE && UI_DISPLAY_TYPE<4
+    setShownRow(r,printCols);
+#endif // FEATURE_DIFFERENTIAL_DISPLAY_UPDATE && UI_DISPLAY_TYPE<4
+
 } // printRowP
 
 
@@ -1330,6 +1436,37 @@ void UIDisplay::parse(char *txt,bool ram)
                     printCols[col++]='%';
                 break;
             }
+            case 'T':                                                                                   // %T0..9, %TC, %Tb : time until extruder 0..9, current extruder, heated bed reaches its target, otherwise the output level
+            {
+                TemperatureController*  tc = NULL;
+
+
+                if(c2>='0' && c2<='9' && c2-'0'<NUM_EXTRUDER)   tc = &extruder[c2-'0'].tempControl;
+                else if(c2=='C')                                tc = &Extruder::current->tempControl;
+#if HAVE_HEATED_BED
+                else if(c2=='b')                                tc = &heatedBedController;
+#endif // HAVE_HEATED_BED
+
+                if(!tc) break;
+#if FEATURE_HEATUP_ETA
+                if(tc->heatUpEta > 0)
+                {
+                    ivalue = tc->heatUpEta;
+                    if(ivalue>5999) ivalue = 5999;                                                      // mm:ss
+                    addInt(ivalue/60,2);
+                    if(col<MAX_COLS)
+                        printCols[col++]=':';
+                    addInt(ivalue%60,2,'0');
+                    break;
+                }
+#endif // FEATURE_HEATUP_ETA
+
+                ivalue=(pwm_pos[tc->pwmIndex]*100)/255;
+                addInt(ivalue,3);
+                if(col<MAX_COLS)
+                    printCols[col++]='%';
+                break;
+            }
             case 'x':
             {
                 char    bDefect = false;
@@ -1542,6 +1679,10 @@ void UIDisplay::parse(char *txt,bool ram)
                         addStringP(PSTR(UI_TEXT_STRING_HM_DEADTIME));
                     else if(hm == 2)
                         addStringP(PSTR(UI_TEXT_STRING_HM_SLOWBANG));
+#if FEATURE_HEAT_MODEL_CONTROL
+                    else if(hm == 4)
+                        addStringP(PSTR(UI_TEXT_STRING_HM_MODEL));
+#endif // FEATURE_HEAT_MODEL_CONTROL
                     else
                         addStringP(PSTR(UI_TEXT_STRING_HM_BANGBANG));
                 }
@@ -2186,6 +2327,71 @@ const UIMenu * const ui_pages[UI_NUM_PAGES] PROGMEM = UI_PAGES;
 
 #if SDSUPPORT
 uint8_t nFilesOnCard;
+
+#if FEATURE_SD_DIRECTORY_INDEX
+/** \brief Adds the file filePos, which starts at the directory position position, to the index of the current folder. In case the index is full, every 2nd
+index entry is dropped and only every 2nd, 4th, ... file is indexed from now on. */
+static void addSDIndexEntry(uint8_t filePos,uint32_t position,dir_t* p,SdBaseFile* root)
+{
+    if(filePos % uid.sdIndexStride)
+    {
+        // this file is not indexed
+        return;
+    }
+
+    if(uid.sdIndexCount >= SD_DIRECTORY_INDEX_SIZE)
+    {
+        for(uint8_t i=0; i<SD_DIRECTORY_INDEX_SIZE/2; i++)
+        {
+            uid.sdIndexPosition[i] = uid.sdIndexPosition[i*2];
+            uid.sdIndexHash[i]     = uid.sdIndexHash[i*2];
+        }
+        uid.sdIndexCount  = SD_DIRECTORY_INDEX_SIZE/2;
+        uid.sdIndexStride *= 2;
+
+        if(filePos % uid.sdIndexStride)
+        {
+            return;
+        }
+    }
+
+    uid.sdIndexPosition[uid.sdIndexCount] = (uint16_t)(position >> 5);
+    uid.sdIndexHash[uid.sdIndexCount]     = root->lfn_checksum(p->name);
+    uid.sdIndexCount ++;
+
+} // addSDIndexEntry
+
+
+/** \brief Positions the current folder in front of the file filePos or in front of the closest indexed file before it. Returns the number of files which
+still have to be skipped. */
+static uint8_t seekSDIndexEntry(uint8_t filePos,SdBaseFile* root)
+{
+    if(uid.sdIndexCount && uid.sdIndexCluster == root->firstCluster())
+    {
+        uint8_t     slot = filePos / uid.sdIndexStride;
+        uint32_t    position;
+        dir_t*      p;
+
+
+        if(slot >= uid.sdIndexCount) slot = uid.sdIndexCount - 1;
+        position = (uint32_t)uid.sdIndexPosition[slot] << 5;
+
+        // make sure that the folder has not been changed since the index was built
+        if(uid.sdIndexChangeCount == SdBaseFile::dirChangeCount() && root->seekSet(position) && (p = root->getLongFilename(NULL, NULL, 0, NULL)) != NULL &&
+           root->lfn_checksum(p->name) == uid.sdIndexHash[slot] && root->seekSet(position))
+        {
+            return filePos - slot * uid.sdIndexStride;
+        }
+        uid.sdIndexCount = 0;
+    }
+
+    root->rewind();
+    return filePos;
+
+} // seekSDIndexEntry
+#endif // FEATURE_SD_DIRECTORY_INDEX
+
+
 void UIDisplay::updateSDFileCount()
 {
     dir_t* p = NULL;
@@ -2194,6 +2400,29 @@ void UIDisplay::updateSDFileCount()
 
     root->rewind();
     nFilesOnCard = 0;
+
+#if FEATURE_SD_DIRECTORY_INDEX
+    uint32_t position = 0;
+
+    sdIndexCluster     = root->firstCluster();
+    sdIndexCount       = 0;
+    sdIndexStride      = 1;
+    sdIndexChangeCount = SdBaseFile::dirChangeCount();
+    while ((p = root->getLongFilename(p, NULL, 0, NULL)))
+    {
+        uint32_t start = position;
+
+        position = root->curPosition();
+        if (! (DIR_IS_FILE(p) || DIR_IS_SUBDIR(p)))
+            continue;
+        if (folderLevel>=SD_MAX_FOLDER_DEPTH && DIR_IS_SUBDIR(p) && !(p->name[0]=='.' && p->name[1]=='.'))
+            continue;
+        addSDIndexEntry(nFilesOnCard, start, p, root);
+        nFilesOnCard++;
+        if (nFilesOnCard==254)
+            return;
+    }
+#else
     while ((p = root->getLongFilename(p, NULL, 0, NULL)))
     {
     if (! (DIR_IS_FILE(p) || DIR_IS_SUBDIR(p)))
@@ -2204,6 +2433,7 @@ void UIDisplay::updateSDFileCount()
         if (nFilesOnCard==254)
             return;
     }
+#endif // FEATURE_SD_DIRECTORY_INDEX
 
 } // updateSDFileCount
 
@@ -2214,7 +2444,11 @@ void getSDFilenameAt(byte filePos,char *filename)
     //byte c=0;
     SdBaseFile *root = sd.fat.vwd();
 
+#if FEATURE_SD_DIRECTORY_INDEX
+    filePos = seekSDIndexEntry(filePos, root);
+#else
     root->rewind();
+#endif // FEATURE_SD_DIRECTORY_INDEX
     while ((p = root->getLongFilename(p, tempLongFilename, 0, NULL)))
     {
         if (!DIR_IS_FILE(p) && !DIR_IS_SUBDIR(p)) continue;
@@ -2274,9 +2508,13 @@ void sdrefresh(uint8_t &r,char cache[UI_ROWS][MAX_COLS+1])
 
     sd.fat.chdir(uid.cwd);
     root = sd.fat.vwd();
-    root->rewind();
 
+#if FEATURE_SD_DIRECTORY_INDEX
+    skip = seekSDIndexEntry(offset>0?offset-1:0, root);
+#else
+    root->rewind();
     skip = (offset>0?offset-1:0);
+#endif // FEATURE_SD_DIRECTORY_INDEX
 
     while (r+offset<nFilesOnCard+1 && r<UI_ROWS && (p = root->getLongFilename(p, tempLongFilename, 0, NULL)))
     {
@@ -2502,6 +2740,12 @@ void UIDisplay::refreshPage()
     uint8_t off0 = (shift<=0 ? 0 : shift);
     uint8_t scroll = dt;
     uint8_t off[UI_ROWS];
+#if FEATURE_DIFFERENTIAL_DISPLAY_UPDATE && UI_DISPLAY_TYPE<4
+    // displayCache holds the characters which are shown by the display, it is updated by updateDisplay()
+    for(y=0; y<UI_ROWS; y++)
+    {
+        uint8_t len = strlen(transition == 0 ? cache[y] : displayCache[y]);
+#else
     if(transition == 0)
     {
         for(y=0; y<UI_ROWS; y++)
@@ -2510,6 +2754,7 @@ void UIDisplay::refreshPage()
     for(y=0; y<UI_ROWS; y++)
     {
         uint8_t len = strlen(displayCache[y]);
+#endif // FEATURE_DIFFERENTIAL_DISPLAY_UPDATE && UI_DISPLAY_TYPE<4
         off[y] = len>UI_COLS ? RMath::min(len-UI_COLS,off0) : 0;
 
 #if UI_ANIMATION
@@ -2541,8 +2786,32 @@ void UIDisplay::refreshPage()
 
         if(transition == 0)
         {
+#if FEATURE_DIFFERENTIAL_DISPLAY_UPDATE && UI_DISPLAY_TYPE<4
+            for(y=0; y<UI_ROWS; y++)
+            {
+                char*   txt = &cache[y][off[y]];
+                uint8_t x;
+
+                for(x=0; x<UI_COLS; x++)
+                {
+                    displayFrame[y][x] = *txt ? *txt++ : ' ';
+                }
+            }
+
+#if UI_SHADOW_REWRITE_INTERVAL
+            if(++displayRewriteCount >= UI_SHADOW_REWRITE_INTERVAL * UI_ROWS) displayRewriteCount = 0;
+            if(!(displayRewriteCount % UI_SHADOW_REWRITE_INTERVAL))
+            {
+                // rewrite one row completely from time to time, so that disturbed characters do not remain on the display
+                memset(displayCache[displayRewriteCount / UI_SHADOW_REWRITE_INTERVAL],0,UI_COLS);
+            }
+#endif // UI_SHADOW_REWRITE_INTERVAL
+
+            updateDisplay();
+#else
             for(y=0; y<UI_ROWS; y++)
                 printRow(y,&cache[y][off[y]],NULL,UI_COLS);
+#endif // FEATURE_DIFFERENTIAL_DISPLAY_UPDATE && UI_DISPLAY_TYPE<4
         }
 #if UI_ANIMATION
         else
@@ -2616,7 +2885,11 @@ void UIDisplay::refreshPage()
     // copy to last cache
     if(transition != 0)
         for(y=0; y<UI_ROWS; y++)
+#if FEATURE_DIFFERENTIAL_DISPLAY_UPDATE && UI_DISPLAY_TYPE<4
+            setShownRow(y,cache[y]);
+#else
             strcpy(displayCache[y],cache[y]);
+#endif // FEATURE_DIFFERENTIAL_DISPLAY_UPDATE && UI_DISPLAY_TYPE<4
     oldMenuLevel = menuLevel;
 #endif // UI_ANIMATION
 
@@ -2739,6 +3012,9 @@ void UIDisplay::okAction()
             ent =(UIMenuEntry *)pgm_read_word(&(entries[menuPos[menuLevel-1]]));
             action = pgm_read_word(&(ent->action));
         }
+#if FEATURE_SD_PREFLIGHT_SCAN
+        sd.stopPreflightScan();
+#endif // FEATURE_SD_PREFLIGHT_SCAN
         sd.file.close();
         sd.fat.chdir(cwd);
         switch(action)
@@ -3786,7 +4062,11 @@ void UIDisplay::nextPreviousAction(int8_t next)
         }
         case UI_ACTION_EXTR_HEATMANAGER:
         {
+#if FEATURE_HEAT_MODEL_CONTROL
+            INCREMENT_MIN_MAX(Extruder::current->tempControl.heatManager,1,0,4);
+#else
             INCREMENT_MIN_MAX(Extruder::current->tempControl.heatManager,1,0,3);
+#endif // FEATURE_HEAT_MODEL_CONTROL
 
 #if FEATURE_AUTOMATIC_EEPROM_UPDATE
             HAL::eprSetFloat(EEPROM::getExtruderOffset(Extruder::current->id)+EPR_EXTRUDER_HEAT_MANAGER,Extruder::current->tempControl.heatManager);
@@ -5509,6 +5789,13 @@ void UIDisplay::slowAction()
         refreshPage();
         lastRefresh = time;
     }
+#if FEATURE_DIFFERENTIAL_DISPLAY_UPDATE && UI_DISPLAY_TYPE<4
+    else if(displayUpdatePending)
+    {
+        // write the characters which did not fit into the previous update
+        updateDisplay();
+    }
+#endif // FEATURE_DIFFERENTIAL_DISPLAY_UPDATE && UI_DISPLAY_TYPE<4
 
 } // slowAction
 
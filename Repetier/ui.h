@@ -417,6 +417,11 @@ public:
     PGM_P               statusText;
     char                locked;
 
+#if FEATURE_DIFFERENTIAL_DISPLAY_UPDATE
+    bool                displayUpdatePending;       // not all changed characters have been written to the display yet
+    uint8_t             displayRewriteCount;        // counts the refreshes, one row is rewritten completely every UI_SHADOW_REWRITE_INTERVAL refreshes
+#endif // FEATURE_DIFFERENTIAL_DISPLAY_UPDATE
+
     void addInt(int value,uint8_t digits,char fillChar=' '); // Print int into printCols
     void addLong(long value,char digits);
     void addFloat(float number, char fixdigits,uint8_t digits);
@@ -432,6 +437,10 @@ public:
     void printRowP(uint8_t r,PGM_P txt);
     void parse(char *txt,bool ram); /// Parse output and write to printCols;
     void refreshPage();
+#if FEATURE_DIFFERENTIAL_DISPLAY_UPDATE
+    void updateDisplay();
+    void setShownRow(uint8_t r,const char *txt);
+#endif // FEATURE_DIFFERENTIAL_DISPLAY_UPDATE
     void executeAction(int action);
     void finishAction(int action);
     void slowAction();
@@ -457,6 +466,15 @@ public:
     char                cwd[SD_MAX_FOLDER_DEPTH*LONG_FILENAME_LENGTH+2];
     uint8_t             folderLevel;
 
+#if FEATURE_SD_DIRECTORY_INDEX
+    uint16_t            sdIndexPosition[SD_DIRECTORY_INDEX_SIZE];   // position of every sdIndexStride-th file of the folder [directory entries]
+    uint8_t             sdIndexHash[SD_DIRECTORY_INDEX_SIZE];       // checksum of the 8.3 name of the indexed files
+    uint32_t            sdIndexCluster;                             // first cluster of the indexed folder
+    uint8_t             sdIndexCount;                               // number of used index entries, 0 = the index is not valid
+    uint8_t             sdIndexStride;                              // number of files per index entry
+    uint8_t             sdIndexChangeCount;                         // SdBaseFile::dirChangeCount() when the index was built
+#endif // FEATURE_SD_DIRECTORY_INDEX
+
     void updateSDFileCount();
     void goDir(char *name);
     bool isDirname(char *name);
@@ -272,6 +272,9 @@
 #define UI_TEXT_EXTR_WAIT_RETRACT_UNITS "Wait Units: %XU mm"
 #define UI_TEXT_SD_REMOVED              "SD Card removed"
 #define UI_TEXT_SD_INSERTED             "SD Card inserted"
+#define UI_TEXT_SD_READ_ERROR           "SD Read Error"
+#define UI_TEXT_PREFLIGHT_OK            "File checked: ok"
+#define UI_TEXT_PREFLIGHT_OUT_OF_RANGE  "File range error"
 #define UI_TEXT_PRINTER_READY           "Printer ready."
 #define UI_TEXT_MILLER_READY            "Miller ready."
 #define UI_TEXT_DO_HEAT_BED_SCAN        "Matrix Scan"
@@ -376,6 +379,7 @@
 #define UI_TEXT_POWER                   "ATX Power on/off"
 #define UI_TEXT_STRING_HM_DEADTIME      "Dead Time"
 #define UI_TEXT_STRING_HM_SLOWBANG      "SlowBang"
+#define UI_TEXT_STRING_HM_MODEL         "Model"
 #define UI_TEXT_STOP_PRINT              "Stop Print"
 #define UI_TEXT_STOP_PRINT_ACK          "Stop Print now?","","%mYYes","%mNNo"
 #define UI_TEXT_STOP_MILL               "Stop Mill"
@@ -415,10 +419,10 @@
     #define UI_TEXT_FAN_50                  "Fan to     50%%%"
     #define UI_TEXT_FAN_75                  "Fan to     75%%%"
     #define UI_TEXT_FAN_FULL                "Fan to    100%%%"
-    #define UI_TEXT_PAGE_EXTRUDER           "E: %ec/%Ec\002C->%oC"
-    #define UI_TEXT_PAGE_EXTRUDER1          "E0:%e0/%E0\002C->%o0"
-    #define UI_TEXT_PAGE_EXTRUDER2          "E1:%e1/%E1\002C->%o1"
-    #define UI_TEXT_PAGE_BED                "B: %eb/%Eb\002C->%ob"
+    #define UI_TEXT_PAGE_EXTRUDER           "E: %ec/%Ec\002C->%TC"
+    #define UI_TEXT_PAGE_EXTRUDER1          "E0:%e0/%E0\002C->%T0"
+    #define UI_TEXT_PAGE_EXTRUDER2          "E1:%e1/%E1\002C->%T1"
+    #define UI_TEXT_PAGE_BED                "B: %eb/%Eb\002C->%Tb"
     #define UI_TEXT_EXTRUDER_OFFSET_X       "Extruder Offset X"
     #define UI_TEXT_EXTRUDER_OFFSET_Y       "Extruder Offset Y"
     #define UI_TEXT_EXTRUDER_OFFSET_Z       "Extruder T1 TipDown"
@@ -451,10 +455,10 @@
     #define UI_TEXT_FAN_50                  "Fan to 50%%%"
     #define UI_TEXT_FAN_75                  "Fan to 75%%%"
     #define UI_TEXT_FAN_FULL                "Fan to 100%%%"
-    #define UI_TEXT_PAGE_EXTRUDER           "E:%ec/%Ec\002C\176%oC"
-    #define UI_TEXT_PAGE_EXTRUDER1          "E0:%e0/%E0\002C\176%o0"
-    #define UI_TEXT_PAGE_EXTRUDER2          "E1:%e1/%E1\002C\176%o1"
-    #define UI_TEXT_PAGE_BED                "B: %eb/%Eb\002C\176%ob"
+    #define UI_TEXT_PAGE_EXTRUDER           "E:%ec/%Ec\002C\176%TC"
+    #define UI_TEXT_PAGE_EXTRUDER1          "E0:%e0/%E0\002C\176%T0"
+    #define UI_TEXT_PAGE_EXTRUDER2          "E1:%e1/%E1\002C\176%T1"
+    #define UI_TEXT_PAGE_BED                "B: %eb/%Eb\002C\176%Tb"
     #define UI_TEXT_EXTRUDER_OFFSET_X       "Extr. Offset X"
     #define UI_TEXT_EXTRUDER_OFFSET_Y       "Extr. Offset Y"
     #define UI_TEXT_EXTRUDER_OFFSET_Z       "Extr.T1 TipDown"
@@ -740,6 +744,7 @@
 #define UI_TEXT_POWER                   "ATX Netzteil an/aus"
 #define UI_TEXT_STRING_HM_DEADTIME      "Totzeit"
 #define UI_TEXT_STRING_HM_SLOWBANG      "Langs.BB"
+#define UI_TEXT_STRING_HM_MODEL         "Modell"
 
 #define UI_ACTION_TEXT_CLASSICPID "PID Ziegler-Nichols"
 #define UI_ACTION_TEXT_PESSEN "PID Pessen-Rule"
@@ -791,10 +796,10 @@
     #define UI_TEXT_FAN_50                  "L" STR_uuml "fter auf  50%%%"
     #define UI_TEXT_FAN_75                  "L" STR_uuml "fter auf  75%%%"
     #define UI_TEXT_FAN_FULL                "L" STR_uuml "fter auf 100%%%"
-    #define UI_TEXT_PAGE_EXTRUDER           "E: %ec/%Ec\002C->%oC"
-    #define UI_TEXT_PAGE_EXTRUDER1          "E0:%e0/%E0\002C->%o0"
-    #define UI_TEXT_PAGE_EXTRUDER2          "E1:%e1/%E1\002C->%o1"
-    #define UI_TEXT_PAGE_BED                "B: %eb/%Eb\002C->%ob"
+    #define UI_TEXT_PAGE_EXTRUDER           "E: %ec/%Ec\002C->%TC"
+    #define UI_TEXT_PAGE_EXTRUDER1          "E0:%e0/%E0\002C->%T0"
+    #define UI_TEXT_PAGE_EXTRUDER2          "E1:%e1/%E1\002C->%T1"
+    #define UI_TEXT_PAGE_BED                "B: %eb/%Eb\002C->%Tb"
     #define UI_TEXT_QUICK_SETTINGS          "Schnelleinstellung"
     #define UI_TEXT_SET_XY_ORIGIN           "Setze XY Ursprung"
     #define UI_TEXT_DISABLE_STEPPER         "Motoren ausschalten"
@@ -815,6 +820,9 @@
     #define UI_TEXT_FLOW_MULTIPLY           "Fluss Mul.  :%of%%%"
     #define UI_TEXT_SD_REMOVED              "SD Karte entfernt"
     #define UI_TEXT_SD_INSERTED             "SD Karte erkannt"
+    #define UI_TEXT_SD_READ_ERROR           "SD Lesefehler"
+    #define UI_TEXT_PREFLIGHT_OK            "Datei gepr" STR_uuml "ft: ok"
+    #define UI_TEXT_PREFLIGHT_OUT_OF_RANGE  "Datei Bereichsfehler"
     #define UI_TEXT_ALIGN_EXTRUDERS         "Extruder ausrichten"
     #define UI_TEXT_MILLER_ONE_TRACK        "eine Spur"
     #define UI_TEXT_MILLER_TWO_TRACKS       "zwei Spuren"
@@ -863,10 +871,10 @@
     #define UI_TEXT_FAN_50                  "L" STR_uuml "fter auf 50%%%"
     #define UI_TEXT_FAN_75                  "L" STR_uuml "fter auf 75%%%"
     #define UI_TEXT_FAN_FULL                "L" STR_uuml "fter auf 100%%%"
-    #define UI_TEXT_PAGE_EXTRUDER           "E:%ec/%Ec\002C\176%oC"
-    #define UI_TEXT_PAGE_EXTRUDER1          "E0:%e0/%E0\002C\176%o0"
-    #define UI_TEXT_PAGE_EXTRUDER2          "E1:%e1/%E1\002C\176%o1"
-    #define UI_TEXT_PAGE_BED                "B: %eb/%Eb\002C\176%ob"
+    #define UI_TEXT_PAGE_EXTRUDER           "E:%ec/%Ec\002C\176%TC"
+    #define UI_TEXT_PAGE_EXTRUDER1          "E0:%e0/%E0\002C\176%T0"
+    #define UI_TEXT_PAGE_EXTRUDER2          "E1:%e1/%E1\002C\176%T1"
+    #define UI_TEXT_PAGE_BED                "B: %eb/%Eb\002C\176%Tb"
     #define UI_TEXT_QUICK_SETTINGS          "Schnelleinst."
     #define UI_TEXT_SET_XY_ORIGIN           "Setze XY Urspr."
     #define UI_TEXT_DISABLE_STEPPER         "Motoren aussch."
@@ -887,6 +895,9 @@
     #define UI_TEXT_FLOW_MULTIPLY           "Fluss Mul.:%of%%%"
     #define UI_TEXT_SD_REMOVED              "SD Karte entf."
     #define UI_TEXT_SD_INSERTED             "SD Karte eing."
+    #define UI_TEXT_SD_READ_ERROR           "SD Lesefehler"
+    #define UI_TEXT_PREFLIGHT_OK            "Datei ok"
+    #define UI_TEXT_PREFLIGHT_OUT_OF_RANGE  "Bereichsfehler"
     #define UI_TEXT_ALIGN_EXTRUDERS         "Extruder ausr."
     #define UI_TEXT_MILLER_ONE_TRACK        "eine S."
     #define UI_TEXT_MILLER_TWO_TRACKS       "zwei S."
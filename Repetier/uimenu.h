@@ -47,6 +47,9 @@ List of placeholder:
 %o0..9 : Output level extruder 0..9 is % including %sign
 %oC : Output level current extruder
 %ob : Output level heated bed
+%T0..9 : Time until extruder 0..9 reaches its target temperature (mm:ss), otherwise its output level
+%TC : Time until current extruder reaches its target temperature, otherwise its output level
+%Tb : Time until heated bed reaches its target temperature, otherwise its output level
 %%% : The % char
 %x0 : X position
 %x1 : Y position